@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace seu {
+
+// 只读内存映射文件，只能移动不能复制
+// 页面由内核按需换入，读取大文件时不会在堆上复制一份
+class MappedFile {
+  public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string &path);
+    ~MappedFile();
+
+    MappedFile(MappedFile &&other) noexcept;
+    auto operator=(MappedFile &&other) noexcept -> MappedFile &;
+    MappedFile(const MappedFile &) = delete;
+    auto operator=(const MappedFile &) -> MappedFile & = delete;
+
+    auto data() const -> const char * { return m_data; }
+    auto size() const -> std::size_t { return m_size; }
+
+  private:
+    auto unmap() -> void;
+
+    const char *m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+} // namespace seu
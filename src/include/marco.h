@@ -1,4 +1,5 @@
 #pragma once
+#include "rng.h"
 #include <array>
 #include <fstream>
 #include <gurobi_c++.h>
@@ -196,7 +197,8 @@ using GRBVar4DArray = vector<GRBVar3DArray>;
 #define US_FPGA 0
 #endif
 
-#define MY_RAND() ((double)((double)rand() / (double)RAND_MAX))
+// [0, 1) 均匀分布，来自可设置种子的随机数服务
+#define MY_RAND() (seu::RngService::local().uniform01())
 
 #define init_clk_reg(id, pos, clb, bram, dsp, num_bram, num_dsp, pos_bram,     \
                      pos_dsp)                                                  \
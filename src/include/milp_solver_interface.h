@@ -91,12 +91,163 @@ class milp_solver_interface {
 };
 using msiRef = shared_ptr<milp_solver_interface>;
 
+// 多目标的组合方式
+// 1. WEIGHTED：各项的加权和
+// 2. WASTED_FIRST / WIRELENGTH_FIRST：按字典序（Gurobi setObjectiveN 的
+//    priority），浪费的资源按权重合成一个目标，布线长度为另一个目标
+enum class pynq_priority { WEIGHTED = 0, WASTED_FIRST, WIRELENGTH_FIRST };
+
+// PYNQ MILP 的建模方式
+// 1. LEGACY：所有条件约束使用同一个 BIG_M
+// 2. TIGHT：每类条件约束使用由 W、H 与资源列数导出的 big-M，并在没有连接
+//    关系时按 x[i][0] 对槽排序以消除对称解；LP 松弛更紧，但有连接关系时
+//    求解未必更快
+enum class pynq_formulation { LEGACY = 0, TIGHT };
+
+// PYNQ MILP 的目标函数权重；布线长度一项按 wl_max 归一化到 [0, 1]，只有
+// 存在连接关系时才非零
+struct pynq_objective {
+    double wasted_clb = 1.0;
+    double wasted_bram = 0.0;
+    double wasted_dsp = 0.0;
+    double wirelength = 0.0;
+    pynq_priority priority = pynq_priority::WEIGHTED;
+};
+
+// 一次 PYNQ MILP 求解的输入，由 start_optimizer 从 param_to_solver 填入；
+// 每个 milp_solver_pynq 各有一份，不同实例可以在不同线程中同时求解
+struct pynq_context {
+  public:
+    int H = 0, W = 0;            // 高，宽
+    int num_slots = 0;           // 槽数
+    int num_rows = 0;            // 行数
+    int num_forbidden_slots = 0; // 禁区槽数
+    int num_clk_regs = 0;        // 时钟区域
+
+    int clb_per_tile = 0;
+    int bram_per_tile = 0;
+    int dsp_per_tile = 0;
+
+    // 浪费的资源
+    int wasted_clb_pynq = 0, wasted_bram_pynq = 0, wasted_dsp_pynq = 0;
+
+    vector<int> clb_req_pynq = vector<int>(MAX_SLOTS);
+    vector<int> bram_req_pynq = vector<int>(MAX_SLOTS);
+    vector<int> dsp_req_pynq = vector<int>(MAX_SLOTS);
+
+    Taskset *task_set = nullptr;
+    Platform *platform = nullptr;
+    vector<double> slacks = vector<double>(MAX_SLOTS);
+
+    vector<vector<int>> conn_matrix_pynq =
+        vector<vector<int>>(MAX_SLOTS, vector<int>(MAX_SLOTS, 0));
+    int num_conn_slots_pynq = 0;
+
+    Vecpos fs_pynq = Vecpos(MAX_SLOTS);
+
+    // 目标函数与重配置方式，修改权重不需要重新构建模型
+    pynq_objective weights;
+    bool preemptive_FRI = false;
+    pynq_formulation formulation = pynq_formulation::LEGACY;
+    // 归一化布线长度的上界（epsilon 约束），1 即不限制
+    double wirelength_bound = 1.0;
+
+    // Gurobi 参数：并行求解多个布局时按核数分配 threads
+    int threads = 8;
+    double time_limit = 1800;
+
+    // 最近一次求解的状态与目标值，wasted_*_pynq 与 wirelength 为解中各项的值
+    // （没有可行解时为 0）；objective 为优先级最高的目标的值，objectives
+    // 按 setObjectiveN 的编号（0 浪费的资源，1 布线长度）存放各目标的值，
+    // WEIGHTED 时只有加权和一项
+    int status = 0;
+    double objective = 0;
+    vector<double> objectives;
+    double wirelength = 0;
+    unsigned long wl_max = 0;
+};
+
+// 模型结构的指纹：只有资源需求、WCET、重配置时间、slacks、资源总量变化时
+// 指纹不变，模型骨架可以复用
+auto pynq_model_shape(const pynq_context &ctx, const Taskset &t,
+                      const Platform &platform, bool preemptive_FRI)
+    -> vector<long>;
+// 是否按 x[i][0] 对槽排序（"sym" 约束）：TIGHT 且没有连接关系时
+auto pynq_breaks_symmetry(const pynq_context &ctx) -> bool;
+
+// PYNQ MILP 的求解会话，可在多次求解（以及同一线程中的多个
+// milp_solver_pynq）之间共享；Gurobi 环境不能被多个线程同时使用
+// 1. 环境只创建一次
+// 2. 模型结构（槽数、任务数、SW/HW 任务关系、禁区、连接关系）不变时保留模型，
+//    只修改随数据变化的系数与右端项：资源需求（con 4）、WCET（con 7/8/9）、
+//    重配置时间（con 8）、slacks（con 9）、资源总量（con 3）
+// 3. 复用模型时以上一次的解（分配与槽的位置、大小）作为 MIP 初始解
+struct milp_session_pynq {
+  public:
+    void clear();
+    // 记录当前解 / 把记录的解设为初始解
+    void save_incumbent();
+    void warm_start();
+
+  public:
+    GRBEnv env;
+    std::unique_ptr<GRBModel> model;
+    vector<long> shape;
+    int builds = 0;
+    int solves = 0;
+    // 累计的建模（build_model / update_model）与 Gurobi 求解时间，单位秒
+    double model_seconds = 0;
+    double solve_seconds = 0;
+
+    // 求解后读取结果或更新数据时需要的变量
+    GRBVar2DArray A, b, I_SLOT, DELTA, DELTA_NP;
+    GRBVarArray gamma_part, r;
+    GRBVar2DArray x, clb, bram, dsp;
+    GRBVarArray y, w, h, clb_fbdn_tot, bram_fbdn_tot, dsp_fbdn_tot;
+
+    // 目标函数的各项，求解前按 pynq_context::weights 组合
+    GRBLinExpr obj_wasted_clb, obj_wasted_bram, obj_wasted_dsp, obj_wirelength;
+    unsigned long wl_max = 0;
+    // obj_wirelength <= wirelength_bound，只在 wl_max > 0 时存在
+    vector<GRBConstr> con_wirelength;
+
+    // 随数据变化的约束，按添加顺序保存
+    vector<GRBConstr> con_total;     // con 3: [x]
+    vector<GRBConstr> con_demand;    // con 4: [x][k][a]
+    vector<GRBConstr> con_slot;      // con 7: [k][a][b]，a != b
+    vector<GRBConstr> con_delta;     // con 8
+    vector<unsigned> con_delta_task; // con 8 对应的 HW 任务 a
+    vector<GRBConstr> con_slack;     // con 9: [i]
+
+    vector<GRBVar> start_vars;
+    vector<double> start_values;
+};
+using mspRef = std::shared_ptr<milp_session_pynq>;
+
 class milp_solver_pynq : public milp_solver_interface {
   public:
+    milp_solver_pynq() = default;
+    explicit milp_solver_pynq(mspRef session) : m_session(session) {}
+
     virtual int start_optimizer(pfsRef pfs, ptsRef pts) override;
     int solve_milp_pynq(pfsRef to_sim);
     int solve_milp(Taskset &t, Platform &platform, vector<double> &slacks,
                    bool preemptive_FRI, pfsRef to_sim);
+
+    // 首次使用时创建
+    auto session() -> milp_session_pynq &;
+    auto context() -> pynq_context & { return m_ctx; }
+    // 本实例求解时 Gurobi 使用的线程数
+    void set_threads(int threads) { m_ctx.threads = threads; }
+
+  private:
+    void build_model(milp_session_pynq &s, Taskset &t, Platform &platform,
+                     vector<double> &slacks, bool preemptive_FRI);
+    void update_model(milp_session_pynq &s, Taskset &t, Platform &platform,
+                      vector<double> &slacks);
+
+    pynq_context m_ctx;
+    mspRef m_session;
 };
 
 // class milp_solver_zynq : public milp_solver_interface {
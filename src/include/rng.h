@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+namespace seu {
+
+// 未调用 RngService::set_seed 时使用的默认种子
+constexpr std::uint64_t RNG_DEFAULT_SEED = 42;
+
+// xoshiro256** 随机数生成器，状态由 splitmix64 从种子展开
+// 1. 满足 UniformRandomBitGenerator，可直接用于 <random> 中的分布
+// 2. uniform_int / uniform01 / normal 自行实现，不依赖标准库分布的具体实现，
+//    因此同一种子在 libc++ 与 libstdc++ 下结果逐位相同
+class Rng {
+  public:
+    using result_type = std::uint64_t;
+
+    explicit Rng(std::uint64_t seed = RNG_DEFAULT_SEED);
+
+    // 种子 seed 下编号为 stream 的独立随机流，用于按块/按线程并行生成
+    static auto stream(std::uint64_t seed, std::uint64_t stream) -> Rng;
+
+    static constexpr auto min() -> result_type { return 0; }
+    static constexpr auto max() -> result_type {
+        return std::numeric_limits<result_type>::max();
+    }
+    auto operator()() -> result_type { return next(); }
+
+    auto next() -> std::uint64_t {
+        const std::uint64_t result = rotl(m_s[1] * 5, 7) * 9;
+        const std::uint64_t t = m_s[1] << 17;
+        m_s[2] ^= m_s[0];
+        m_s[3] ^= m_s[1];
+        m_s[1] ^= m_s[2];
+        m_s[0] ^= m_s[3];
+        m_s[2] ^= t;
+        m_s[3] = rotl(m_s[3], 45);
+        return result;
+    }
+
+    // [0, 1) 均匀分布
+    auto uniform01() -> double { return (next() >> 11) * 0x1.0p-53; }
+
+    // [lower, upper] 上的均匀整数（Lemire 无偏区间映射）
+    auto uniform_int(int lower, int upper) -> int;
+
+    // 正态分布（Marsaglia 极坐标法）
+    auto normal(double mean, double stddev) -> double;
+
+  private:
+    static auto rotl(std::uint64_t x, int k) -> std::uint64_t {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t m_s[4];
+    bool m_has_spare = false;
+    double m_spare = 0.0;
+};
+
+auto splitmix64(std::uint64_t x) -> std::uint64_t;
+
+// 全局随机数服务：每个线程一个 Rng
+// 1. set_seed 之后，各线程下次取用时按新种子重新初始化
+// 2. 调用 set_seed 的线程使用 0 号流，其他线程按首次取用的顺序编号；
+//    多线程并行生成且需要逐位复现时，应按块使用 Rng::stream(seed, 块号)
+class RngService {
+  public:
+    static auto set_seed(std::uint64_t seed) -> void;
+    static auto seed() -> std::uint64_t;
+    static auto local() -> Rng &;
+};
+
+} // namespace seu
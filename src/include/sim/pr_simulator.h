@@ -0,0 +1,137 @@
+#pragma once
+#include "sim/scheduler.h"
+#include "task.h"
+#include "task_table.h"
+#include <cstdint>
+#include <vector>
+
+namespace seu {
+
+class Platform;
+struct param_from_solver;
+struct param_to_solver;
+
+// 可重构分区的资源量
+struct SimPartition {
+    int clb = 0;
+    int bram = 0;
+    int dsp = 0;
+};
+
+// 作业放到哪个分区
+// STATIC: 按 SimConfig::allocation（布局求解的 task_alloc）固定分区
+// CACHE: 分区视为位流缓存，作业可以放到任何能容纳它的分区；已配置（或正在
+//        配置）该模块的分区命中，否则在空闲分区中按 EvictionPolicy 选择被
+//        替换的模块；没有空闲分区时作业暂不分配，由最先空闲的分区领取，
+//        即替换在真正重新配置时才决定
+enum class Placement { STATIC, CACHE };
+
+// CACHE 时被替换模块的选择
+// LRU: 最久未使用；LFU: 累计使用次数最少；
+// BELADY: 下一次使用最晚（按作业的到达顺序预知未来，作为离线最优的参照）
+enum class EvictionPolicy { LRU, LFU, BELADY };
+
+// 仿真的硬件配置
+// 1. 每个任务（TaskTable 的行）对应一个模块（部分位流），同一行的多个作业
+//    共享位流，分区中已是该模块时不需要重新配置
+// 2. allocation[row] 为任务所在的分区，-1 或缺省时选择能容纳该任务的、
+//    配置时间最短的分区，相同时选已分配执行时间最少的
+// 3. 配置时间只与分区大小有关：sum(分区资源 * rec_time_per_unit)，
+//    与 milp_model_pynq_with_partition 中的模型一致；TaskTable 的 conf 列不参与
+struct SimConfig {
+    std::vector<SimPartition> partitions;
+    std::vector<int> allocation;
+    std::vector<double> rec_time_per_unit; // 按 CLB/BRAM/DSP 下标
+    // 每个任务（行）相对释放时刻的截止时间（floorplan::slacks），
+    // 为空时没有截止时间
+    std::vector<double> slacks;
+    Placement placement = Placement::STATIC;
+    EvictionPolicy eviction = EvictionPolicy::LRU;
+    // 预取错误（分区的就绪作业需要别的模块）时是否中止正在进行的预取；
+    // 中止后 ICAP 还要忙 prefetch_cancel_cost，剩余配置时间不超过它时不中止
+    bool prefetch_cancel = false;
+    double prefetch_cancel_cost = 0.0;
+
+    // 由 milp_solver_pynq 的结果构建，task_alloc 中的任务编号视为
+    // TaskTable 的行号
+    static auto from_solver(const param_from_solver &solution,
+                            const Platform &platform) -> SimConfig;
+    // 同上，另从求解输入中取出 slacks：MILP 的 con 9 按 SW 任务约束截止
+    // 时间，每个 HW 任务（行）取使用它的 SW 任务中最小的 slack，
+    // 不被任何 SW 任务使用的行没有截止时间
+    static auto from_solver(const param_from_solver &solution,
+                            const param_to_solver &problem) -> SimConfig;
+};
+
+// 一个作业：执行一次 row 对应的任务，release 时刻之后才能开始
+struct SimJob {
+    int row = 0;
+    double release = 0.0;
+};
+
+struct SimReport {
+    double makespan = 0.0;
+    double icap_busy = 0.0;
+    double icap_utilization = 0.0;
+    long reconfigurations = 0;
+    long events = 0;
+    long unfinished = 0; // 依赖无法满足（有环）的作业
+    long deadline_misses = 0;
+    double throughput = 0.0;   // 作业数 / makespan
+    long prefetches = 0;       // 预取的配置次数，包含在 reconfigurations 中
+    long prefetch_hits = 0;    // 直接使用预取模块的作业数
+    long prefetch_wasted = 0;  // 未被使用就被替换或中止的预取
+    long prefetch_cancels = 0; // 中止的预取
+    long cache_hits = 0;       // 分区中已是所需模块的作业数（不含预取命中）
+    double hit_rate = 0.0;     // cache_hits / 作业数
+    double rec_time_saved = 0.0; // 命中节省的配置时间
+    std::vector<double> partition_busy; // 配置 + 运行的时间
+    std::vector<double> partition_idle; // makespan 内其余的时间
+    std::vector<double> finish;         // 每个作业的完成时刻
+};
+
+// 部分重配置的离散事件仿真
+// 1. 事件表为按 (时刻, 序号) 排列的二叉堆，同一时刻的事件按产生顺序处理
+// 2. 作业依次经过 WAITING -> CONFIGURING -> RUNNING -> ENDING；
+//    分区中已是所需模块时跳过 CONFIGURING
+// 3. 每个分区执行分配给它的作业，整个器件只有一个配置端口 (ICAP)，
+//    同一时刻只能配置一个分区；分区内作业的先后和 ICAP 的使用顺序由
+//    Scheduler 决定（见 scheduler.h），默认为 FifoScheduler
+class PrSimulator {
+  public:
+    // 只保存 tasks 的引用，调用方须保证其在模拟器之后析构；禁止传入临时
+    // 对象，避免悬空引用
+    PrSimulator(const TaskTable &tasks, SimConfig config);
+    PrSimulator(TaskTable &&tasks, SimConfig config) = delete;
+
+    auto set_scheduler(SchedulerRef scheduler) -> void {
+        m_scheduler = std::move(scheduler);
+    }
+    auto scheduler() const -> const SchedulerRef & { return m_scheduler; }
+
+    // 相互独立的作业（如生产环境的调用序列）
+    auto run(const std::vector<SimJob> &jobs) -> SimReport;
+    // TaskTable 中的每个任务执行一次，父任务全部完成后子任务才就绪
+    auto run_graph() -> SimReport;
+
+    // 最近一次仿真结束时各作业的状态
+    auto status(std::size_t job) const -> TaskStatus { return m_status[job]; }
+    auto partition_of(int row) const -> int { return m_partition_of[row]; }
+    auto reconfiguration_time(int partition) const -> double {
+        return m_rec_time[partition];
+    }
+
+  private:
+    auto simulate(const std::vector<SimJob> &jobs, bool dependencies)
+        -> SimReport;
+
+    const TaskTable &m_tasks;
+    SimConfig m_config;
+    std::vector<int> m_partition_of; // row -> 分区
+    std::vector<std::vector<int>> m_fitting; // row -> 能容纳它的分区（CACHE）
+    std::vector<double> m_rec_time;  // 分区 -> 配置时间
+    std::vector<TaskStatus> m_status;
+    SchedulerRef m_scheduler;
+};
+
+} // namespace seu
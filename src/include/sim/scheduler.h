@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+
+namespace seu {
+
+constexpr double NO_DEADLINE = std::numeric_limits<double>::infinity();
+
+// 调度器看到的作业信息
+struct SchedJob {
+    int job = 0;
+    int row = 0;
+    double release = 0.0;
+    double deadline = NO_DEADLINE; // release + floorplan::slacks[row]
+    std::uint64_t ready_seq = 0;   // 就绪的先后顺序
+};
+
+// 在线调度策略
+// 1. priority 越小越先执行：同一分区的就绪作业之间，以及等待 ICAP 的分区之间
+// 2. prefer_loaded 为 true 时，分区优先执行与当前已配置模块相同的作业
+// 3. prefetch 为 true 时，分区空闲且没有就绪作业时提前配置下一个将要执行的
+//    任务的模块；真正的配置请求总是优先于预取。按 DAG 仿真时，只预取父任务
+//    都已开始运行的任务，按预计就绪时刻（父任务的最晚完成时刻）先后选择
+// 仿真器为每个分区维护一个二叉堆，每次决策 O(log n)
+class Scheduler {
+  public:
+    virtual ~Scheduler() = default;
+
+    virtual auto name() const -> std::string = 0;
+    virtual auto priority(const SchedJob &job) const -> double = 0;
+    virtual auto prefer_loaded() const -> bool { return false; }
+    virtual auto prefetch() const -> bool { return false; }
+};
+using SchedulerRef = std::shared_ptr<Scheduler>;
+
+// 按就绪顺序
+class FifoScheduler : public Scheduler {
+  public:
+    auto name() const -> std::string override { return "fifo"; }
+    auto priority(const SchedJob &job) const -> double override {
+        return static_cast<double>(job.ready_seq);
+    }
+};
+
+// 截止时间最早的优先
+class EdfScheduler : public Scheduler {
+  public:
+    auto name() const -> std::string override { return "edf"; }
+    auto priority(const SchedJob &job) const -> double override {
+        return job.deadline;
+    }
+};
+
+// 优先执行不需要重新配置的作业，其余按就绪顺序
+class LeastReconfigScheduler : public FifoScheduler {
+  public:
+    auto name() const -> std::string override { return "least-reconfig"; }
+    auto prefer_loaded() const -> bool override { return true; }
+};
+
+// 在 LeastReconfigScheduler 的基础上预取下一个模块
+class PrefetchScheduler : public LeastReconfigScheduler {
+  public:
+    auto name() const -> std::string override { return "prefetch"; }
+    auto prefetch() const -> bool override { return true; }
+};
+
+enum class SchedulePolicy { FIFO, EDF, LEAST_RECONFIG, PREFETCH };
+
+auto make_scheduler(SchedulePolicy policy) -> SchedulerRef;
+
+} // namespace seu
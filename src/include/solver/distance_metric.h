@@ -0,0 +1,107 @@
+#pragma once
+#include "marco.h"
+#include "task_table.h"
+#include <algorithm>
+#include <cmath>
+
+namespace seu {
+
+// 聚类使用的距离度量，作为模板参数在编译期选定，内层循环没有虚函数调用
+// 每个度量提供：
+// 1. task(v, r): 聚类前对任务的第 r 种资源做一次变换（r: 0 clb, 1 dsp, 2 bram）
+// 2. center(v, r): 每轮对聚类中心做同样的变换
+// 3. combine(dx, dy, dz): 把变换后三个分量的差合成距离的平方
+// 聚类中心始终是原始资源量的均值，只有比较距离时才变换
+
+// 原始资源量上的欧式距离
+struct EuclideanMetric {
+    auto task(double v, int) const -> double { return v; }
+    auto center(double v, int) const -> double { return v; }
+    static auto combine(double dx, double dy, double dz) -> double {
+        return dx * dx + dy * dy + dz * dz;
+    }
+};
+
+// 按资源加权的欧式距离：w_clb * dclb^2 + w_dsp * ddsp^2 + w_bram * dbram^2
+struct WeightedMetric {
+    WeightedMetric(double clb, double dsp, double bram)
+        : m_scale{std::sqrt(clb), std::sqrt(dsp), std::sqrt(bram)} {}
+
+    auto task(double v, int r) const -> double { return v * m_scale[r]; }
+    auto center(double v, int r) const -> double { return v * m_scale[r]; }
+    static auto combine(double dx, double dy, double dz) -> double {
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    double m_scale[3];
+};
+
+// 标准化欧式距离：每种资源除以它在任务集上的标准差，
+// 避免数量级大的 CLB 主导聚类
+struct NormalizedMetric {
+    // 按任务集统计各资源的标准差；标准差为 0 的资源不缩放
+    static auto fit(const TaskTable &tasks) -> NormalizedMetric {
+        NormalizedMetric metric;
+        const Span<const int> columns[3] = {tasks.clb(), tasks.dsp(),
+                                            tasks.bram()};
+        const double n = static_cast<double>(tasks.size());
+        for (int r = 0; r < 3; ++r) {
+            double sum = 0.0, sum2 = 0.0;
+            for (auto v : columns[r]) {
+                sum += v;
+                sum2 += static_cast<double>(v) * v;
+            }
+            double var = n > 0 ? sum2 / n - (sum / n) * (sum / n) : 0.0;
+            metric.m_scale[r] = var > 0.0 ? 1.0 / std::sqrt(var) : 1.0;
+        }
+        return metric;
+    }
+
+    auto task(double v, int r) const -> double { return v * m_scale[r]; }
+    auto center(double v, int r) const -> double { return v * m_scale[r]; }
+    static auto combine(double dx, double dy, double dz) -> double {
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    double m_scale[3] = {1.0, 1.0, 1.0};
+};
+
+// 切比雪夫距离：各资源差的最大值，与 getClusterMaxResourcesNumber
+// 按每种资源的最大值确定区域大小的方式一致；默认以 PYNQ 每个 tile
+// 的资源量为单位，使三种资源可比
+struct ChebyshevMetric {
+    ChebyshevMetric()
+        : ChebyshevMetric(1.0 / PYNQ_CLB_PER_TILE, 1.0 / PYNQ_DSP_PER_TILE,
+                          1.0 / PYNQ_BRAM_PER_TILE) {}
+    ChebyshevMetric(double clb, double dsp, double bram)
+        : m_scale{clb, dsp, bram} {}
+
+    auto task(double v, int r) const -> double { return v * m_scale[r]; }
+    auto center(double v, int r) const -> double { return v * m_scale[r]; }
+    static auto combine(double dx, double dy, double dz) -> double {
+        return std::max(std::max(dx * dx, dy * dy), dz * dz);
+    }
+
+    double m_scale[3];
+};
+
+// 按 tile 量化：任务占用整数个 tile（向上取整），中心换算为 tile 数后比较
+struct TileMetric {
+    TileMetric()
+        : TileMetric(PYNQ_CLB_PER_TILE, PYNQ_DSP_PER_TILE, PYNQ_BRAM_PER_TILE) {
+    }
+    TileMetric(double clb, double dsp, double bram)
+        : m_per_tile{clb, dsp, bram} {}
+
+    auto task(double v, int r) const -> double {
+        return std::ceil(v / m_per_tile[r]);
+    }
+    auto center(double v, int r) const -> double { return v / m_per_tile[r]; }
+    static auto combine(double dx, double dy, double dz) -> double {
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    double m_per_tile[3];
+};
+
+} // namespace seu
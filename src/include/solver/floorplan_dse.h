@@ -0,0 +1,127 @@
+#pragma once
+#include "milp_solver_interface.h"
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace seu {
+
+// 一个 RM 模块，与 config["dart"]["hw_ips"] 中的一项对应
+struct DseModule {
+    int clb = 0;
+    int bram = 0;
+    int dsp = 0;
+    double wcet = 0;
+    double slack = 0;
+};
+
+// 设计空间中的一个点：使用前 num_modules 个模块
+struct DsePoint {
+    int num_modules = 0;
+    pynq_objective weights;
+    bool preemptive_FRI = false;
+    pynq_formulation formulation = pynq_formulation::LEGACY;
+
+    // 输入完全相同的点 key 相同，用于去重与断点续跑
+    auto key() const -> std::string;
+};
+
+// 各维度的取值，grid 取笛卡尔积，sample 每一维独立均匀抽取；formulations
+// 取 {LEGACY, TIGHT} 时两种建模方式在相同输入上对比
+struct DseSpace {
+    std::vector<int> module_counts;
+    std::vector<pynq_objective> weights = {pynq_objective()};
+    std::vector<bool> preemptive_FRI = {false};
+    std::vector<pynq_formulation> formulations = {pynq_formulation::LEGACY};
+
+    auto grid() const -> std::vector<DsePoint>;
+    auto sample(std::size_t n, std::uint64_t seed) const
+        -> std::vector<DsePoint>;
+};
+
+// 求解抛出异常的点的状态，不是 Gurobi 的状态码
+constexpr int DSE_FAILED = -1;
+
+struct DseResult {
+    DsePoint point;
+    int status = 0;     // Gurobi 状态，求解出错时为 DSE_FAILED
+    std::string error;  // 出错时的异常信息
+    double objective = 0;
+    int partitions = 0; // 最优解中的分区数
+    int wasted_clb = 0;
+    int wasted_bram = 0;
+    int wasted_dsp = 0;
+    double wirelength = 0; // 归一化的布线长度
+    double seconds = 0;
+    // 各分区的位置与大小，只在内存中保留，不写入 output
+    std::vector<pos> slots;
+};
+
+struct DseOptions {
+    // 总线程数，0 时使用硬件线程数；按 threads_per_solve 划分为并发的求解
+    unsigned threads = 0;
+    int threads_per_solve = 1;
+    double time_limit = 1800;
+    // 结果逐行追加到该 CSV 文件；为空时不落盘
+    std::string output;
+};
+
+// 布局的设计空间探索
+// 1. 输入点按 key 去重，output 中已有结果的点直接跳过，因此中断后重新运行
+//    只求解剩余的点；output 的版本行记录 fingerprint，与本次的模块、连接
+//    或时间限制不同时报错，不续用其他输入求得的结果
+// 2. 每个工作线程持有一个 milp_solver_pynq，点按模型结构排序，同一线程连续
+//    求解时复用模型（见 milp_session_pynq）；线程从共享下标动态领取下一个点
+// 3. 每个结果求解完立即写入 output 并 flush
+// 4. 某个点求解出错时记录为 DSE_FAILED 与异常信息，其余点照常求解；出错的
+//    点不写入 output，下次运行时重新求解
+class floorplan_dse {
+  public:
+    // connections 的每一行为 {slot_a, slot_b, 线数}，槽从 1 开始编号
+    floorplan_dse(std::vector<DseModule> modules,
+                  std::vector<std::vector<int>> connections,
+                  DseOptions options);
+    virtual ~floorplan_dse() = default;
+
+    // 返回 output 中已有的结果与本次求解的结果，按 points 去重后的顺序
+    auto run(const std::vector<DsePoint> &points) -> std::vector<DseResult>;
+
+    // epsilon 约束法求浪费的资源（按 point.weights 合成）与布线长度之间的
+    // Pareto 前沿：每次在布线长度上界下按字典序先最小化浪费、再最小化布线
+    // 长度，再把上界收紧到刚得到的布线长度以下，直到不可行或得到 max_points
+    // 个点；结果按布线长度递减，不写入 output
+    auto pareto(const DsePoint &point, std::size_t max_points)
+        -> std::vector<DseResult>;
+
+    // 模块、连接与时间限制的指纹：这些输入不在 DsePoint 中，但决定求解结果
+    auto fingerprint() const -> std::uint64_t;
+
+    // 读取 output 中的结果，忽略不完整或取值越界的行（例如崩溃时写了一半的
+    // 行）；第一行不是当前格式的版本行，或给出 fingerprint 而与文件中的不同
+    // 时抛出异常
+    static auto load(const std::string &path,
+                     std::optional<std::uint64_t> fingerprint = std::nullopt)
+        -> std::vector<DseResult>;
+    static auto dedup(const std::vector<DsePoint> &points)
+        -> std::vector<DsePoint>;
+
+  protected:
+    // 求解一个点，出错时抛出异常；测试中可以替换
+    virtual auto solve(milp_solver_pynq &solver, const DsePoint &point,
+                       double wirelength_bound = 1.0) -> DseResult;
+
+  private:
+    auto append(const DseResult &result) -> void;
+
+    std::vector<DseModule> m_modules;
+    std::vector<std::vector<int>> m_connections;
+    DseOptions m_options;
+
+    std::mutex m_mutex;
+    std::ofstream m_out;
+};
+
+} // namespace seu
@@ -0,0 +1,88 @@
+#pragma once
+#include "partition.h"
+#include <cstddef>
+#include <vector>
+
+namespace seu {
+
+// 干扰项的模型
+// FULL: 论文中的模型，即 solve_milp 启用约束 0.5（r 的下界）与 0.9
+//       （DELTA_NP 的下界）时同名变量的最小可行值
+// AS_BUILT: 与当前的 solve_milp 一致：这两组约束被注释掉，r 与 DELTA_NP
+//           只有下界 0，最小可行值为 0，响应时间中只剩 WCET 与 I_SLOT
+enum class InterferenceModel { FULL, AS_BUILT };
+
+// 固定分配下的干扰项，为 InterferenceModel 对应的 MILP 中同名变量的最小
+// 可行值；矩阵按行优先存放在一维数组中
+// 1. b[x][k] 为分区 k 中任务第 x 类资源需求的最大值，分区中多于一个任务时
+//    其中的任务需要重配置（gamma），r[a] = gamma[a] * Σ recTimePerUnit[x] *
+//    b[x][k]（AS_BUILT 时为 0）
+// 2. I_SLOT[a][b]：同一分区的另一个任务 b 造成的干扰，为 b 的 WCET
+// 3. DELTA[a][i]：需要重配置的任务 a 受第 i 个 SW 任务所用 HW 任务的干扰，
+//    取 max(I_SLOT[a][b] + r[b])，i 为 a 所属的 SW 任务时为 0
+// 4. DELTA_NP[a][b]（非抢占式重配置）：a、b 同一分区且 a 需要重配置时，为其他
+//    分区中需要重配置的任务的最大 r（AS_BUILT 时为 0）
+// 5. 第 i 个 SW 任务的响应时间为其每个 HW 任务 a 的 r[a] + WCET +
+//    Σ_{j != i} DELTA[a][j]（+ Σ_b DELTA_NP[a][b]），不超过 slacks[i] 时可调度
+struct InterferenceResult {
+    std::size_t hw_tasks = 0;
+    std::size_t sw_tasks = 0;
+    std::vector<char> gamma;        // hw_tasks
+    std::vector<double> rec_time;   // r，hw_tasks
+    std::vector<double> i_slot;     // hw_tasks x hw_tasks
+    std::vector<double> delta;      // hw_tasks x sw_tasks
+    std::vector<double> delta_np;   // hw_tasks x hw_tasks，抢占式时为空
+    std::vector<double> response;   // sw_tasks
+    std::vector<double> slack_left; // slacks[i] - response[i]
+    bool feasible = false;
+};
+
+// 干扰分析：构造时把 Taskset / Platform 展开成连续数组，之后每次分析 O(n^2)，
+// 可以在交给 MILP 之前大量筛选候选分区方案
+// partition_of[a] 为第 a 个 HW 任务所在的分区，等价于 A[a][k] == 1
+class interference_analysis {
+  public:
+    interference_analysis(const Taskset &t, const Platform &platform,
+                          InterferenceModel model = InterferenceModel::FULL);
+
+    // 计算全部干扰项
+    auto evaluate(const std::vector<int> &partition_of,
+                  const std::vector<double> &slacks, bool preemptive_FRI)
+        -> InterferenceResult;
+
+    // 只计算响应时间并判断可调度性，不生成矩阵
+    auto feasible(const std::vector<int> &partition_of,
+                  const std::vector<double> &slacks, bool preemptive_FRI)
+        -> bool;
+
+    // 由 A[a][k] 矩阵得到 partition_of；每行必须恰有一个 1
+    static auto from_matrix(const std::vector<std::vector<int>> &A)
+        -> std::vector<int>;
+
+  private:
+    auto prepare(const std::vector<int> &partition_of) -> void;
+    auto response(std::size_t i, bool preemptive_FRI,
+                  InterferenceResult *out) const -> double;
+
+    InterferenceModel m_model;
+    std::size_t m_hw = 0;
+    std::size_t m_sw = 0;
+    std::size_t m_res = 0;
+    std::size_t m_partitions = 0;
+    std::vector<double> m_wcet;
+    std::vector<double> m_demand;       // hw x res
+    std::vector<double> m_rec_per_unit; // res
+    std::vector<int> m_sw_of;           // HW 任务所属的 SW 任务
+    std::vector<int> m_hw_offsets;      // SW 任务 -> HW 任务的 CSR
+    std::vector<int> m_hw_rows;
+
+    // prepare 的结果，每次分析复用
+    const int *m_part = nullptr;
+    std::vector<int> m_count;   // 分区中的任务数
+    std::vector<double> m_size; // partitions x res，即 b
+    std::vector<double> m_rec;  // 分区的重配置时间
+    std::vector<double> m_r;    // 任务的 r
+    std::vector<double> m_np;   // 分区外需要重配置的任务的最大 r
+};
+
+} // namespace seu
@@ -0,0 +1,68 @@
+#pragma once
+#include "solver/kmeanspp.h"
+#include "solver/packed_tasks.h"
+#include <vector>
+
+namespace seu {
+
+// 中心 j 移动 moved[j] 后放松 Hamerly 上下界：u[i] 加上所属中心的移动距离，
+// l[i] 减去其他中心中最大的移动距离；只要求距离满足三角不等式，
+// kmeans_metric 在变换后的空间中同样使用
+auto relax_hamerly_bounds(const std::vector<double> &moved,
+                          const std::vector<int> &assignments,
+                          std::vector<double> &upper,
+                          std::vector<double> &lower) -> void;
+
+// Hamerly 加速的 K-Means 迭代引擎
+// 每个任务维护到所属中心距离的上界 u 和到其他中心距离的下界 l，
+// 利用三角不等式跳过大部分距离计算；结果与普通 Lloyd 迭代一致
+// incremental 为 true 时维护每个类的资源和，每轮只移动改变归属的任务，
+// 不再重新累加全部任务（AssignEngine::INCREMENTAL）
+class kmeans_hamerly {
+  public:
+    explicit kmeans_hamerly(const PackedTasks &tasks, bool incremental = false)
+        : m_tasks(tasks), m_incremental(incremental) {}
+
+    // centroids 为初始中心，结束时为收敛后的中心；返回迭代次数
+    auto run(std::vector<Centroid> &centroids, std::vector<int> &assignments,
+             double tolerance, int max_iterations) -> int;
+
+    // 最近一次 run 中实际计算的任务-中心距离次数（用于评估剪枝效果）
+    auto distance_evaluations() const -> long { return m_evaluations; }
+    // 最近一次 run 中初始分配之后改变归属的次数
+    auto moved_tasks() const -> long { return m_moved_tasks; }
+
+  private:
+    auto load_centroids(const std::vector<Centroid> &centroids) -> void;
+    auto assign_all(std::vector<int> &assignments) -> void;
+    auto assign_one(std::size_t i, int &best) -> void;
+    auto update_centroids(const std::vector<int> &assignments) -> double;
+    auto update_half_separation() -> void;
+    auto accumulate(const std::vector<int> &assignments) -> void;
+    auto move_task(std::size_t i, int from, int to) -> void;
+
+    const PackedTasks &m_tasks;
+    const bool m_incremental;
+
+    // 聚类中心按列存储
+    std::vector<double> m_cclb;
+    std::vector<double> m_cdsp;
+    std::vector<double> m_cbram;
+
+    std::vector<double> m_upper; // u[i]
+    std::vector<double> m_lower; // l[i]
+    std::vector<double> m_half;  // s[j]: 中心 j 到最近其他中心距离的一半
+    std::vector<double> m_moved; // p[j]: 本轮中心 j 的移动距离
+    std::vector<double> m_dist2; // assign_one 的临时缓冲
+
+    // 每个类的资源和与任务数；资源量都是整数，累加没有舍入误差
+    std::vector<double> m_sx;
+    std::vector<double> m_sy;
+    std::vector<double> m_sz;
+    std::vector<long> m_count;
+
+    long m_evaluations = 0;
+    long m_moved_tasks = 0;
+};
+
+} // namespace seu
@@ -0,0 +1,47 @@
+#pragma once
+#include "solver/distance_metric.h"
+#include "solver/kmeanspp.h"
+#include "solver/packed_tasks.h"
+#include <vector>
+
+namespace seu {
+
+// 使用指定距离度量的 K-Means
+// 1. 初始化：options.seeding 为 PROVIDED 时使用传入的中心，
+//    否则在度量下做 K-Means++（按距离平方加权采样）
+// 2. 迭代：按度量分配任务，维护每个类原始资源量的和，只移动改变归属的任务，
+//    没有任务改变归属或达到 max_iterations 时停止；分配时在变换后的空间中
+//    维护 Hamerly 上下界（各度量都满足三角不等式），跳过不可能改变归属的任务
+// 只为 distance_metric.h 中的度量显式实例化
+template <typename Metric> class kmeans_metric {
+  public:
+    kmeans_metric(const TaskTable &tasks, const Metric &metric);
+
+    auto run(std::vector<Centroid> &centroids, std::vector<int> &assignments,
+             const ClusterOptions &options) -> ClusterStats;
+
+    // 任务 row 到中心 c 的距离平方
+    auto distance(std::size_t row, const Centroid &c) const -> double;
+
+  private:
+    auto project_centers(const std::vector<Centroid> &centroids) -> void;
+    auto seed(int k, std::uint64_t seed) -> std::vector<Centroid>;
+    auto assign_all(std::vector<int> &nearest) -> void;
+    auto assign_one(std::size_t row) -> int;
+    auto center_distance(std::size_t row, std::size_t j) const -> double;
+    auto update_separation(const std::vector<Centroid> &previous) -> void;
+
+    const TaskTable &m_tasks;
+    Metric m_metric;
+    PackedTasks m_projected;         // 变换后的任务
+    std::vector<Centroid> m_centers; // 变换后的中心
+
+    // 变换后空间中的距离（combine 的平方根）上下界
+    std::vector<double> m_upper; // 到所属中心距离的上界
+    std::vector<double> m_lower; // 到其他中心距离的下界
+    std::vector<double> m_half;  // 中心到最近其他中心距离的一半
+    std::vector<double> m_moved; // 本轮中心的移动距离
+    long m_evaluations = 0;
+};
+
+} // namespace seu
@@ -0,0 +1,28 @@
+#pragma once
+#include "solver/kmeanspp.h"
+#include "task_stream.h"
+#include <tuple>
+#include <vector>
+
+namespace seu {
+
+// mini-batch K-Means（流式）
+// 1. 用流中的第一批任务按 options.seeding 选出初始中心，
+//    PROVIDED 时直接使用传入的中心
+// 2. 每次读入 batch_size 个任务，分到最近的中心，
+//    中心 j 按学习率 1 / v[j] 向本批任务移动，v[j] 为累计分到 j 的任务数
+// 3. 一轮遍历后中心的最大移动距离不超过 tolerance，或达到 epochs 轮时停止
+// 只保存一个批次和 k 个中心，内存占用与任务总数无关
+class kmeans_minibatch {
+  public:
+    static auto cluster(TaskStream &stream, std::vector<Centroid> &centroids,
+                        const ClusterOptions &options) -> ClusterStats;
+
+    // 每个类中各资源的最大值，下标为类编号；空类为 (0, 0, 0)
+    static auto max_resources(TaskStream &stream,
+                              const std::vector<Centroid> &centroids,
+                              std::size_t batch_size)
+        -> std::vector<std::tuple<int, int, int>>;
+};
+
+} // namespace seu
@@ -0,0 +1,21 @@
+#pragma once
+#include "solver/kmeanspp.h"
+#include "solver/packed_tasks.h"
+#include <vector>
+
+namespace seu {
+
+// k-means|| (scalable K-Means++) 初始化
+// 1. 随机选一个任务作为第一个候选中心
+// 2. 每轮按 oversampling * k * d^2 / cost 的概率独立采样任务作为候选，
+//    各任务到候选集的最近距离数组跨轮复用，只与新加入的候选比较
+// 3. 按每个候选吸引的任务数加权，在候选集上做 K-Means++ 与加权 Lloyd，
+//    得到最终的 k 个中心
+// 采样按固定大小的块划分，每块有独立的随机流，结果只取决于种子，与线程数无关
+class kmeans_parallel {
+  public:
+    static auto seed(const PackedTasks &tasks, int k,
+                     const ClusterOptions &options) -> std::vector<Centroid>;
+};
+
+} // namespace seu
@@ -0,0 +1,45 @@
+#pragma once
+#include "solver/kmeanspp.h"
+#include <vector>
+
+namespace seu {
+
+// 扫描聚类个数 k 的结果
+// 1. [kmin, kmax] 按固定长度切成若干段，各段并行；段内第一个 k 按 options.seeding
+//    初始化，之后的 k + 1 以 k 的收敛中心为热启动，再按 d^2 加一个新中心，
+//    新中心的采样直接复用 k 收敛时各任务到所属中心的距离
+// 2. 每个 k 计算三个指标：
+//    area: 各类资源最大值之和（实际要在 FPGA 上预留的面积），越小越好
+//    silhouette: 简化轮廓系数 (b - a) / max(a, b) 的平均值，a 为到所属中心的距离，
+//                b 为到最近其他中心的距离，越大越好
+//    inertia: 距离平方和，用于肘部法
+// 3. 在 (area 最小, silhouette 最大) 上取 Pareto 前沿；inertia 随 k 单调
+//    减小而 area 单调增大，两者一起会让每个 k 都在前沿上，因此 inertia
+//    不参与支配，只按肘部法给出其曲线拐点处的 k
+// 分段只取决于区间，与线程数无关；相同种子结果相同
+struct KSweepPoint {
+    int k = 0;
+    ClusterResult result;
+    double area = 0;
+    double silhouette = 0;
+    double inertia = 0;
+};
+
+struct KSweepResult {
+    std::vector<KSweepPoint> points; // 按 k 从小到大
+    std::vector<int> front;          // Pareto 前沿上的 k，从小到大
+    int elbow = 0; // 归一化 inertia 曲线上距首尾连线最远的 k
+};
+
+class kmeans_sweep {
+  public:
+    static auto run(const TaskTable &tasks, int kmin, int kmax,
+                    const ClusterOptions &options) -> KSweepResult;
+
+    // 简化轮廓系数的平均值；k < 2 时为 0
+    static auto silhouette(const TaskTable &tasks,
+                           const std::vector<Centroid> &centroids,
+                           const std::vector<int> &assignments) -> double;
+};
+
+} // namespace seu
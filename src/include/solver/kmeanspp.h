@@ -2,11 +2,80 @@
 #include "marco.h"
 #include "task.h"
 #include "task_manager.h"
+#include "task_stream.h"
+#include "task_table.h"
+#include <cstdint>
 #include <tuple>
 #include <unordered_map>
 
 namespace seu {
 
+class ThreadPool;
+
+// 未指定种子时使用的默认随机种子，保证聚类结果可复现
+constexpr std::uint64_t KMEANS_DEFAULT_SEED = 42;
+
+// 聚类中心（资源使用量的均值，不再用 Task 对象表示）
+struct Centroid {
+    double clb = 0;
+    double dsp = 0;
+    double bram = 0;
+};
+
+// 分配步骤使用的引擎
+// LLOYD: 每轮计算任务到全部中心的距离，并重新累加全部任务得到新中心
+// INCREMENTAL: 维护每个类的资源和，只移动归属改变的任务；分配时同 HAMERLY
+//              用上下界跳过不可能改变归属的任务；没有任务改变归属时停止
+// HAMERLY: 用上下界剪枝跳过不可能改变归属的任务，结果与 LLOYD 相同；
+//          每轮重新累加全部任务得到新中心
+enum class AssignEngine { LLOYD, INCREMENTAL, HAMERLY };
+
+// 初始中心的选择方式
+// KMEANSPP: 顺序 K-Means++，每轮选出一个中心
+// KMEANS_PARALLEL: k-means||，每轮并行过采样多个候选，再把候选加权聚成 k 个
+// PROVIDED: 直接使用调用者传入的 centroids 作为初始中心（热启动）
+enum class SeedMode { KMEANSPP, KMEANS_PARALLEL, PROVIDED };
+
+struct ClusterOptions {
+    double tolerance = 0.1;
+    int max_iterations = 100;
+    AssignEngine engine = AssignEngine::LLOYD;
+
+    SeedMode seeding = SeedMode::KMEANSPP;
+    std::uint64_t seed = KMEANS_DEFAULT_SEED;
+    double oversampling = 2.0; // k-means|| 每轮期望采样 oversampling * k 个候选
+    int rounds = 5;            // k-means|| 采样轮数
+    ThreadPool *pool = nullptr; // 为空时单线程执行
+
+    // mini-batch（流式）聚类使用
+    std::size_t batch_size = 1024; // 每批读取的任务数
+    int epochs = 10;               // 最多遍历数据的次数
+};
+
+// 一次聚类的统计信息
+// mini-batch 聚类不保存每个任务的归属：iterations 为处理的批次数，
+// moved_tasks 与 distance_evaluations 为 0
+struct ClusterStats {
+    int iterations = 0;   // 迭代次数
+    long moved_tasks = 0; // 初始分配之后，各轮改变归属的任务数之和
+    long distance_evaluations = 0; // 实际计算的任务-中心距离次数
+};
+
+// 多次重启时选择结果的标准
+// INERTIA: 任务到所属中心的距离平方和最小
+// MAX_RESOURCES: 各类资源最大值（getClusterMaxResourcesNumber）的总和最小，
+//                clb/dsp/bram 直接相加
+enum class RestartCriterion { INERTIA, MAX_RESOURCES };
+
+// 一次完整聚类的结果
+struct ClusterResult {
+    std::vector<Centroid> centroids;
+    std::vector<int> assignments;
+    ClusterStats stats;
+    double score = 0;       // 按选择标准计算的得分，越小越好
+    std::uint64_t seed = 0; // 得到该结果的种子
+};
+
 class kmeanspp {
   public:
     // 计算两个任务之间的欧式距离
@@ -16,7 +85,9 @@ class kmeanspp {
     // K-Means++算法初始化聚类中心，选择初始的k个聚类中心
     static auto
     initCentroidsKMeansPlusPlus(const std::unordered_map<int, TaskRef> &m_tasks,
-                                std::vector<TaskRef> &centroids, int k) -> void;
+                                std::vector<TaskRef> &centroids, int k,
+                                std::uint64_t seed = KMEANS_DEFAULT_SEED)
+        -> void;
     // 将任务分配到距离最近的聚类中心所在的类
     static auto assignTasks(const std::unordered_map<int, TaskRef> &m_tasks,
                             const std::vector<TaskRef> &centroids,
@@ -40,10 +111,82 @@ class kmeanspp {
                              double tolerance, int max_iterations) -> void;
 
     static auto getClusterMaxResourcesNumber(
-        std::unordered_map<int, std::vector<int>> clusterToTask,
-        std::unordered_map<int, TaskRef>
+        const std::unordered_map<int, std::vector<int>> &clusterToTask,
+        const std::unordered_map<int, TaskRef> &task_set)
+        -> std::unordered_map<int, std::tuple<int, int, int>>;
 
-        ) -> std::unordered_map<int, std::tuple<int, int, int>>;
+    // ------------------------------------------------------------------
+    // 基于 TaskTable 的接口：按列遍历任务，assignments[row] 为该行所属的类
+    // ------------------------------------------------------------------
+    static auto euclideanDistance(const TaskTable &tasks, std::size_t row,
+                                  const Centroid &c) -> double;
+
+    static auto
+    initCentroidsKMeansPlusPlus(const TaskTable &tasks,
+                                std::vector<Centroid> &centroids, int k,
+                                std::uint64_t seed = KMEANS_DEFAULT_SEED)
+        -> void;
+
+    static auto assignTasks(const TaskTable &tasks,
+                            const std::vector<Centroid> &centroids,
+                            std::vector<int> &assignments) -> void;
+
+    static auto updateCentroids(const TaskTable &tasks,
+                                const std::vector<int> &assignments,
+                                std::vector<Centroid> &centroids) -> void;
+
+    static auto isConverged(const std::vector<Centroid> &old_centroids,
+                            const std::vector<Centroid> &new_centroids,
+                            double tolerance) -> bool;
+
+    // centroids.size() 即聚类个数 k
+    static auto kMeansPlusPlusClustering(const TaskTable &tasks,
+                                         std::vector<Centroid> &centroids,
+                                         std::vector<int> &assignments,
+                                         double tolerance, int max_iterations)
+        -> void;
+
+    // 按 options 选择迭代引擎，返回迭代次数和移动的任务数
+    static auto kMeansPlusPlusClustering(const TaskTable &tasks,
+                                         std::vector<Centroid> &centroids,
+                                         std::vector<int> &assignments,
+                                         const ClusterOptions &options)
+        -> ClusterStats;
+
+    // 多次重启：第 r 次使用种子 options.seed + r，返回得分最低的结果
+    // （得分相同时取编号小的）。options.pool 非空时各次重启并行执行，
+    // 每次重启内部单线程，结果与线程数无关
+    static auto kMeansPlusPlusRestarts(
+        const TaskTable &tasks, int k, int restarts,
+        const ClusterOptions &options,
+        RestartCriterion criterion = RestartCriterion::INERTIA)
+        -> ClusterResult;
+
+    // 任务到所属中心的距离平方和
+    static auto inertia(const TaskTable &tasks,
+                        const std::vector<Centroid> &centroids,
+                        const std::vector<int> &assignments) -> double;
+
+    // 返回每个类中各资源的最大值，下标为类编号；空类为 (0, 0, 0)
+    static auto getClusterMaxResourcesNumber(const TaskTable &tasks,
+                                             const std::vector<int> &assignments,
+                                             int k)
+        -> std::vector<std::tuple<int, int, int>>;
+
+    // ------------------------------------------------------------------
+    // 流式接口：任务按批读取，内存占用与任务总数无关
+    // ------------------------------------------------------------------
+    // mini-batch K-Means，centroids.size() 即聚类个数 k
+    static auto kMeansPlusPlusClustering(TaskStream &stream,
+                                         std::vector<Centroid> &centroids,
+                                         const ClusterOptions &options)
+        -> ClusterStats;
+
+    // 再遍历一次任务流，把每个任务分到最近的中心，返回每个类中各资源的最大值
+    static auto getClusterMaxResourcesNumber(
+        TaskStream &stream, const std::vector<Centroid> &centroids,
+        std::size_t batch_size = 1024)
+        -> std::vector<std::tuple<int, int, int>>;
 };
 
 } // namespace seu
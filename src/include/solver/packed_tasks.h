@@ -0,0 +1,26 @@
+#pragma once
+#include "task_table.h"
+#include <cstddef>
+#include <vector>
+
+namespace seu {
+
+// 聚类内核使用的打包数据：clb/dsp/bram 三列转换为连续的 double 数组
+// 内层循环直接按列读取，便于编译器自动向量化
+struct PackedTasks {
+    std::vector<double> clb;
+    std::vector<double> dsp;
+    std::vector<double> bram;
+
+    auto size() const -> std::size_t { return clb.size(); }
+
+    static auto from_table(const TaskTable &tasks) -> PackedTasks {
+        PackedTasks packed;
+        packed.clb.assign(tasks.clb().begin(), tasks.clb().end());
+        packed.dsp.assign(tasks.dsp().begin(), tasks.dsp().end());
+        packed.bram.assign(tasks.bram().begin(), tasks.bram().end());
+        return packed;
+    }
+};
+
+} // namespace seu
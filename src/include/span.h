@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace seu {
+
+// 连续内存的只读/可写视图（C++17 下 std::span 的最小替代）
+// 不拥有数据，只保存指针和长度，按值传递即可
+template <typename T> class Span {
+  public:
+    constexpr Span() = default;
+    constexpr Span(T *data, std::size_t size) : m_data(data), m_size(size) {}
+
+    template <typename U>
+    Span(std::vector<U> &v) : m_data(v.data()), m_size(v.size()) {}
+    template <typename U>
+    Span(const std::vector<U> &v) : m_data(v.data()), m_size(v.size()) {}
+
+    constexpr auto data() const -> T * { return m_data; }
+    constexpr auto size() const -> std::size_t { return m_size; }
+    constexpr auto empty() const -> bool { return m_size == 0; }
+
+    constexpr auto begin() const -> T * { return m_data; }
+    constexpr auto end() const -> T * { return m_data + m_size; }
+
+    constexpr auto operator[](std::size_t i) const -> T & { return m_data[i]; }
+
+    constexpr auto subspan(std::size_t offset, std::size_t count) const
+        -> Span<T> {
+        return Span<T>(m_data + offset, count);
+    }
+
+  private:
+    T *m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+} // namespace seu
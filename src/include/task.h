@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 using std::shared_ptr;
@@ -19,23 +21,27 @@ enum class TaskStatus { WAITING, CONFIGURING, RUNNING, ENDING };
 // 2. 任务对于资源的需求
 // 3. 以及任务之间的依赖关系
 // 任务类
+// 访问器都不复制：依赖关系以 const 引用返回，批量设置依赖时按值传入后移动
 class Task {
   public:
     Task(int id, int clb, int dsp, int bram, int exec);
     Task(int clb, int dsp, int bram, int exec);
-
-    auto getId() { return m_id; }
-    auto getClb() { return m_clb; }
-    auto getDsp() { return m_dsp; }
-    auto getBram() { return m_bram; }
-    auto getConf() { return m_conftime; }
-    auto getExec() { return m_exectime; }
-    auto getParent() { return m_parent; }
-    auto getChildren() { return m_children; }
-    auto getResources() -> std::tuple<int, int, int> {
+    // 带依赖关系构造，children / parents 被移动进任务
+    Task(int id, int clb, int dsp, int bram, int exec, vector<int> children,
+         vector<int> parents);
+
+    auto getId() const { return m_id; }
+    auto getClb() const { return m_clb; }
+    auto getDsp() const { return m_dsp; }
+    auto getBram() const { return m_bram; }
+    auto getConf() const { return m_conftime; }
+    auto getExec() const { return m_exectime; }
+    auto getParent() const -> const vector<int> & { return m_parent; }
+    auto getChildren() const -> const vector<int> & { return m_children; }
+    auto getResources() const -> std::tuple<int, int, int> {
         return {m_clb, m_dsp, m_bram};
     }
-    auto getStatus() { return m_status; }
+    auto getStatus() const { return m_status; }
 
     void addClb(int n) { m_clb += n; }
     void addDsp(int n) { m_dsp += n; }
@@ -44,6 +50,19 @@ class Task {
     void setClb(int n) { m_clb = n; }
     void setDsp(int n) { m_dsp = n; }
     void setBram(int n) { m_bram = n; }
+    void setConf(int n) { m_conftime = n; }
+    void setResources(int clb, int dsp, int bram) {
+        m_clb = clb;
+        m_dsp = dsp;
+        m_bram = bram;
+    }
+
+    // 添加依赖关系（只记录 id，不检查对方任务是否存在）
+    void addChild(int id) { m_children.push_back(id); }
+    void addParent(int id) { m_parent.push_back(id); }
+    // 整体替换依赖关系
+    void setChildren(vector<int> ids) { m_children = std::move(ids); }
+    void setParents(vector<int> ids) { m_parent = std::move(ids); }
 
   private:
     // 任务id
@@ -61,7 +80,7 @@ class Task {
     // 任务的相关状态
     // bool is_root = true; // 标识该任务是否有前序任务
     // bool is_end = false; // 判断该任务是否有后续任务
-    TaskStatus m_status;
+    TaskStatus m_status = TaskStatus::WAITING;
 
     // int m_indegree = 0;  // 入度
     // int m_outdegree = 0; // 出度
@@ -0,0 +1,56 @@
+#pragma once
+#include "span.h"
+#include "task_table.h"
+#include <vector>
+
+namespace seu {
+
+// 任务依赖图（DAG），建立在 TaskTable 的 CSR 邻接表之上，以行号表示任务
+// 1. 构造时用 Kahn 算法求拓扑序，存在环时抛出异常并给出环上的任务 id
+// 2. 层次：没有父任务的任务为第 0 层，其余为父任务最大层次 + 1
+// 3. 关键路径：任务的权重为配置时间 + 执行时间，父任务全部完成后子任务才能
+//    开始配置，关键路径为权重和最大的路径
+// 以上均为 O(任务数 + 边数)
+class TaskGraph {
+  public:
+    explicit TaskGraph(const TaskTable &tasks);
+
+    auto size() const -> std::size_t { return m_order.size(); }
+
+    // 拓扑序（行号）
+    auto order() const -> Span<const int> { return m_order; }
+
+    // 每个任务的层次，以及按层次分组的任务（CSR）
+    auto level(std::size_t row) const -> int { return m_level[row]; }
+    auto level_count() const -> std::size_t {
+        return m_level_offsets.size() - 1;
+    }
+    auto level_rows(std::size_t level) const -> Span<const int> {
+        return Span<const int>(m_level_rows.data() + m_level_offsets[level],
+                               m_level_offsets[level + 1] -
+                                   m_level_offsets[level]);
+    }
+
+    // 所有依赖都满足时，任务最早的完成时间
+    auto earliest_finish(std::size_t row) const -> long {
+        return m_finish[row];
+    }
+    auto critical_path_length() const -> long { return m_critical_length; }
+    // 关键路径上的任务，从源点到终点
+    auto critical_path() const -> std::vector<int>;
+
+    // 图中一个环上的任务（行号），无环时为空
+    static auto find_cycle(const TaskTable &tasks) -> std::vector<int>;
+
+  private:
+    std::vector<int> m_order;
+    std::vector<int> m_level;
+    std::vector<int> m_level_offsets;
+    std::vector<int> m_level_rows;
+    std::vector<long> m_finish;
+    std::vector<int> m_critical_parent; // 关键路径上的前驱，-1 表示源点
+    long m_critical_length = 0;
+    int m_critical_end = -1;
+};
+
+} // namespace seu
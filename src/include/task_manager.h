@@ -1,19 +1,70 @@
 #pragma once
+#include "rng.h"
 #include "task.h"
+#include "task_source.h"
+#include "task_table.h"
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
 namespace seu {
 
+class ThreadPool;
+
+// 批量生成任务时资源的分布
+// UNIFORM: clb/dsp/bram/exec 各自在给定范围内均匀分布（与 task_info_init 相同）
+// CLB_FRACTION: clb 均匀分布，dsp/bram 为 clb 乘以给定区间内的比例
+//               （random_task_gen.py 的分布）
+// NORMAL: clb 服从正态分布并截断到 clb 范围，dsp/bram 同 CLB_FRACTION
+enum class TaskShape { UNIFORM, CLB_FRACTION, NORMAL };
+
+struct TaskGenSpec {
+    TaskShape shape = TaskShape::UNIFORM;
+    std::pair<int, int> clb{2000, 3000};
+    std::pair<int, int> dsp{0, 80};
+    std::pair<int, int> bram{0, 80};
+    std::pair<int, int> exec{5, 50};
+    std::pair<double, double> dsp_fraction{0.10, 0.15};
+    std::pair<double, double> bram_fraction{0.10, 0.15};
+    double clb_mean = 2500;
+    double clb_stddev = 250;
+    std::uint64_t seed = RNG_DEFAULT_SEED;
+
+    // random_task_gen.py 使用的分布
+    static auto python_script() -> TaskGenSpec {
+        TaskGenSpec spec;
+        spec.shape = TaskShape::CLB_FRACTION;
+        spec.clb = {400, 4000};
+        spec.exec = {5, 20};
+        return spec;
+    }
+};
+
 class TaskManager {
   public:
     TaskManager() = default;
 
-    // 从json环境中生成任务
+    // 从json环境中生成任务：内存映射文件后逐个扫描任务，直接写入任务表；
+    // 解析失败时不修改已有任务
     auto init_from_json(const std::string &filename) -> void;
+    // 从多个任务文件加载（见 task_source.h），合并规则与 init_from_json 相同；
+    // 返回各文件的 id 偏移，失败时不修改已有任务并返回空
+    auto init_from_source(const TaskSource &source, IdRemap remap,
+                          ThreadPool *pool = nullptr) -> std::vector<TaskShard>;
+    // 二进制任务集（见 task_set_file.h），文件同样位于 src/info/taskinfo/；
+    // 加载时内存映射后按列复制，不需要解析；合并规则与 init_from_json 相同
+    auto init_from_binary(const std::string &filename) -> void;
+    auto save_binary(const std::string &filename) const -> void;
 
     auto init_from_random() -> void;
     auto init_from_random(int task_num) -> void;
+    // 批量生成 n 个任务追加到随机任务表；按固定大小的块生成，块 c 使用
+    // Rng::stream(spec.seed, c)，结果只取决于 spec，与线程数无关
+    auto init_from_generator(std::size_t n, const TaskGenSpec &spec,
+                             ThreadPool *pool = nullptr) -> void;
+    static auto generate_task_table(std::size_t n, const TaskGenSpec &spec,
+                                    int first_id = 0,
+                                    ThreadPool *pool = nullptr) -> TaskTable;
     auto task_info_init() -> TaskRef;
     auto task_info_init_custom(std::pair<int, int> clb, std::pair<int, int> dsp,
                                std::pair<int, int> bram,
@@ -22,21 +73,36 @@ class TaskManager {
     static auto generate_normal_distribution(double mean, double stddev,
                                              int size) -> std::vector<double>;
 
-    auto getRandomTask() -> std::unordered_map<int, TaskRef> {
-        return m_random_task;
-    };
-    auto getJsonTask() -> std::unordered_map<int, TaskRef> { return m_tasks; };
+    // 旧接口：第一次调用时由任务表生成 map 并缓存，任务表变化后重新生成；
+    // 多次调用返回同一组任务对象，修改其中的任务不会写回任务表
+    auto getRandomTask() -> const std::unordered_map<int, TaskRef> &;
+    auto getJsonTask() -> const std::unordered_map<int, TaskRef> &;
+
+    // 按列存储的任务表，聚类与布局求解优先使用
+    auto getRandomTaskTable() const -> const TaskTable & {
+        return m_random_table;
+    }
+    auto getJsonTaskTable() const -> const TaskTable & { return m_table; }
 
-    auto random_task_set_clear() { m_random_task.clear(); }
-    static void TaskInfoPrint(std::unordered_map<int, TaskRef> TaskSet);
+    auto random_task_set_clear() {
+        m_random_table.clear();
+        m_random_map.reset();
+    }
+    static void TaskInfoPrint(const std::unordered_map<int, TaskRef> &TaskSet);
 
   private:
+    // 把新加载的任务表合并到 m_table，重复 id 以后出现的为准
+    auto merge_loaded(TaskTable &&loaded) -> void;
+
     // init from json
     int task_num = 0;
-    std::unordered_map<int, TaskRef> m_tasks; // 存储id和Task之间的映射关系
+    TaskTable m_table;
     // init from random
     int m_taskid = 0;
-    std::unordered_map<int, TaskRef> m_random_task; // key:id, value:task
+    TaskTable m_random_table;
+    // getJsonTask / getRandomTask 的缓存，任务表变化时清空
+    std::optional<std::unordered_map<int, TaskRef>> m_map;
+    std::optional<std::unordered_map<int, TaskRef>> m_random_map;
 };
 
 } // namespace seu
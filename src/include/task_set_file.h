@@ -0,0 +1,60 @@
+#pragma once
+#include "mapped_file.h"
+#include "span.h"
+#include "task_table.h"
+#include <cstdint>
+#include <string>
+
+namespace seu {
+
+// 二进制任务集文件（小端，按列存储）
+// [头部 64 字节]
+// [id][clb][dsp][bram][exec][conf]           各 task_count 个 int32
+// [child_offsets][parent_offsets]            各 task_count + 1 个 int32
+// [child_rows][parent_rows]                  各 edge_count 个 int32
+// 每段起始按 64 字节对齐，段的位置只由 task_count 和 edge_count 决定
+// 没有依赖关系时两个偏移段的长度为 0
+constexpr char TASK_SET_MAGIC[8] = {'S', 'E', 'U', 'T', 'A', 'S', 'K', 'S'};
+constexpr std::uint32_t TASK_SET_VERSION = 1;
+
+struct TaskSetHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint64_t task_count;
+    std::uint64_t edge_count;
+    std::uint64_t file_size;
+    std::uint32_t has_edges;
+    std::uint32_t reserved[5];
+};
+static_assert(sizeof(TaskSetHeader) == 64, "TaskSetHeader must be 64 bytes");
+
+// 内存映射打开的任务集文件，检查头部后各列直接指向映射区，不做任何解析
+class TaskSetFile {
+  public:
+    explicit TaskSetFile(const std::string &path);
+
+    static auto save(const std::string &path, const TaskTable &tasks) -> void;
+
+    auto size() const -> std::size_t { return m_header.task_count; }
+    auto edge_count() const -> std::size_t { return m_header.edge_count; }
+
+    auto ids() const -> Span<const int> { return column(0); }
+    auto clb() const -> Span<const int> { return column(1); }
+    auto dsp() const -> Span<const int> { return column(2); }
+    auto bram() const -> Span<const int> { return column(3); }
+    auto exec() const -> Span<const int> { return column(4); }
+    auto conf() const -> Span<const int> { return column(5); }
+
+    // 复制到 TaskTable（重建 id 索引并检查依赖关系）
+    auto to_table() const -> TaskTable;
+
+  private:
+    auto column(int section) const -> Span<const int>;
+
+    std::string m_path;
+    MappedFile m_mapped;
+    TaskSetHeader m_header{};
+};
+
+} // namespace seu
@@ -0,0 +1,53 @@
+#pragma once
+#include "task_table.h"
+#include <string>
+#include <vector>
+
+namespace seu {
+
+class ThreadPool;
+
+// 合并多个任务文件时 id 的处理方式
+// KEEP: 保留原 id，不同文件中重复的 id 以后加载的文件为准
+// OFFSET: 每个文件的 id 加上偏移量（之前所有文件的最大 id + 1），
+//         文件之间不会冲突，原 id = 新 id - id_offset
+enum class IdRemap { KEEP, OFFSET };
+
+// 合并结果中每个文件的信息
+struct TaskShard {
+    std::string path;
+    std::size_t tasks = 0; // 文件中的任务数（去重后）
+    int id_offset = 0;     // OFFSET 时该文件 id 的偏移量，KEEP 时为 0
+};
+
+struct TaskSourceResult {
+    TaskTable table;
+    std::vector<TaskShard> shards;
+};
+
+// 任务来源：若干 JSON（.json）或二进制任务集（见 task_set_file.h）文件
+// 1. add 接受绝对路径、相对 base_dir 的路径或 glob 模式，添加时即展开
+// 2. load 并行解析各个文件（每个文件一个任务），再按添加顺序合并为一张任务表
+class TaskSource {
+  public:
+    // 默认目录为 <project root>/src/info/taskinfo
+    TaskSource();
+    explicit TaskSource(std::string base_dir);
+
+    // 没有匹配的文件时抛出异常
+    auto add(const std::string &path_or_pattern) -> TaskSource &;
+    auto files() const -> const std::vector<std::string> & { return m_files; }
+
+    auto load(IdRemap remap, ThreadPool *pool = nullptr) const
+        -> TaskSourceResult;
+
+    static auto default_dir() -> std::string;
+    // 按扩展名/文件头识别格式并加载单个文件；文件内重复的 id 以后出现的为准
+    static auto load_file(const std::string &path) -> TaskTable;
+
+  private:
+    std::string m_base_dir;
+    std::vector<std::string> m_files;
+};
+
+} // namespace seu
@@ -0,0 +1,116 @@
+#pragma once
+#include "mapped_file.h"
+#include "task_table.h"
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace seu {
+
+// 单个任务的原始字段，children 为子任务 id
+struct TaskRecord {
+    int id = 0;
+    int clb = 0;
+    int dsp = 0;
+    int bram = 0;
+    int exec = 0;
+    int conf = 0;
+    std::vector<int> children;
+};
+
+// 一批任务，按列存储；流式读取时不检查 id 是否重复
+struct TaskBatch {
+    std::vector<int> id;
+    std::vector<int> clb;
+    std::vector<int> dsp;
+    std::vector<int> bram;
+    std::vector<int> exec;
+
+    auto size() const -> std::size_t { return id.size(); }
+    auto clear() -> void {
+        id.clear();
+        clb.clear();
+        dsp.clear();
+        bram.clear();
+        exec.clear();
+    }
+};
+
+// 任务流：按固定大小的批次顺序读取任务，内存占用只与批次大小有关
+class TaskStream {
+  public:
+    virtual ~TaskStream() = default;
+
+    // 读取至多 max_tasks 个任务到 batch（先清空），返回读到的个数；0 表示结束
+    virtual auto next_batch(std::size_t max_tasks, TaskBatch &batch)
+        -> std::size_t = 0;
+    // 回到流的开头，重新读取
+    virtual auto reset() -> void = 0;
+};
+
+// 遍历内存中的 TaskTable
+class TableTaskStream : public TaskStream {
+  public:
+    explicit TableTaskStream(const TaskTable &tasks) : m_tasks(tasks) {}
+
+    auto next_batch(std::size_t max_tasks, TaskBatch &batch)
+        -> std::size_t override;
+    auto reset() -> void override { m_row = 0; }
+
+  private:
+    const TaskTable &m_tasks;
+    std::size_t m_row = 0;
+};
+
+// JsonTaskStream 的读取方式
+// BUFFERED: 经固定大小的读缓冲区读取，内存占用只与缓冲区大小有关
+// MAPPED: 内存映射整个文件，直接在映射的字节上解析，没有额外的复制
+enum class JsonReadMode { BUFFERED, MAPPED };
+
+// 流式读取 {"tasks": [{"id": .., "clb": .., "dsp": .., "bram": ..,
+// "exectime": ..}, ...]} 格式的 JSON 文件（random_task_gen.py 的输出格式）
+// 任务可选 "conftime" 和 "children": [子任务 id, ...]，TaskBatch 中不包含这两项
+// 边扫描边取出任务字段，不构建 DOM，也不会把整个文件读入堆内存
+class JsonTaskStream : public TaskStream {
+  public:
+    explicit JsonTaskStream(const std::string &path,
+                            JsonReadMode mode = JsonReadMode::BUFFERED,
+                            std::size_t buffer_size = 1 << 16);
+
+    auto next_batch(std::size_t max_tasks, TaskBatch &batch)
+        -> std::size_t override;
+    auto reset() -> void override;
+
+    // 读取下一个任务，数组结束时返回 false
+    auto next_task(TaskRecord &task) -> bool;
+    // 文件大小（字节），可用于预估任务数
+    auto file_size() const -> std::size_t { return m_file_size; }
+
+  private:
+    auto peek() -> int;
+    auto get() -> int;
+    auto refill() -> bool;
+    auto skip_ws() -> int;
+    auto expect(char c) -> void;
+    auto read_string() -> std::string;
+    auto read_number(int first) -> double;
+    auto read_int(int first) -> int;
+    auto read_id_list(std::vector<int> &ids) -> void;
+    auto skip_value(int first) -> void;
+    auto find_tasks_array() -> void;
+    [[noreturn]] auto fail(const std::string &what) -> void;
+
+    std::string m_path;
+    JsonReadMode m_mode;
+    std::ifstream m_file;
+    std::vector<char> m_buffer;
+    MappedFile m_mapped;
+    std::size_t m_file_size = 0;
+    const char *m_data = nullptr; // 当前可读的字节：读缓冲区或映射区
+    std::size_t m_pos = 0;
+    std::size_t m_len = 0;
+    bool m_done = false;
+};
+
+} // namespace seu
@@ -0,0 +1,125 @@
+#pragma once
+#include "span.h"
+#include "task.h"
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace seu {
+
+// 任务表：按列（struct-of-arrays）连续存储任务属性
+// 1. clb/dsp/bram/exec/conf 各占一列，聚类和布局求解直接按列遍历
+// 2. 行号(row)是任务在表中的下标，id 是任务自身的编号
+// 3. m_index 是 id -> row 的哈希索引，id 可以稀疏（例如按文件加偏移）
+// 4. 依赖关系按行号以 CSR 存储父->子、子->父两个方向，增删任务后需重新设置
+class TaskTable {
+  public:
+    TaskTable() = default;
+
+    // 为 n 个任务预留各列与 id 索引；unordered_map::reserve 会立即分配并清零
+    // 桶数组，只在 n 是确切的任务数时使用
+    auto reserve(std::size_t n) -> void;
+    // 只预留各列的容量，id 索引随插入增长；用于按估计值预分配，未写入的
+    // 容量不会占用物理内存
+    auto reserve_columns(std::size_t n) -> void;
+    auto clear() -> void;
+
+    // 追加一个任务，返回其行号
+    auto push_back(int id, int clb, int dsp, int bram, int exec, int conf = 0)
+        -> std::size_t;
+
+    // 覆盖某一行的资源与时间
+    auto set_row(std::size_t row, int clb, int dsp, int bram, int exec,
+                 int conf = 0) -> void;
+
+    // 批量覆盖 [first_row, first_row + clb.size()) 行的资源，三列长度须相同
+    auto set_resources(std::size_t first_row, Span<const int> clb,
+                       Span<const int> dsp, Span<const int> bram) -> void;
+
+    // 追加 n 行，id 依次为 first_id, first_id + 1, ...，其余列为 0；
+    // 返回第一行的行号。之后通过 mutable_* 按列批量填充
+    auto append_rows(int first_id, std::size_t n) -> std::size_t;
+
+    auto size() const -> std::size_t { return m_id.size(); }
+    auto empty() const -> bool { return m_id.empty(); }
+
+    // 按列只读访问
+    auto ids() const -> Span<const int> { return m_id; }
+    auto clb() const -> Span<const int> { return m_clb; }
+    auto dsp() const -> Span<const int> { return m_dsp; }
+    auto bram() const -> Span<const int> { return m_bram; }
+    auto exec() const -> Span<const int> { return m_exec; }
+    auto conf() const -> Span<const int> { return m_conf; }
+
+    // 按列可写访问，供批量生成/加载时直接填充
+    auto mutable_clb() -> Span<int> { return m_clb; }
+    auto mutable_dsp() -> Span<int> { return m_dsp; }
+    auto mutable_bram() -> Span<int> { return m_bram; }
+    auto mutable_exec() -> Span<int> { return m_exec; }
+    auto mutable_conf() -> Span<int> { return m_conf; }
+
+    // 设置依赖关系，edges 为 (父任务 id, 子任务 id)，覆盖原有的依赖关系
+    auto set_edges(const std::vector<std::pair<int, int>> &edges) -> void;
+    // 直接设置 CSR 数组（偏移长度为 size() + 1，元素为行号），会检查合法性
+    auto set_adjacency(std::vector<int> child_offsets,
+                       std::vector<int> child_rows,
+                       std::vector<int> parent_offsets,
+                       std::vector<int> parent_rows) -> void;
+    // 依赖关系，(父任务 id, 子任务 id)，按父任务行号排列
+    auto edges() const -> std::vector<std::pair<int, int>>;
+    auto edge_count() const -> std::size_t { return m_child_rows.size(); }
+    auto has_edges() const -> bool { return !m_child_offsets.empty(); }
+    // 子任务/父任务的行号
+    auto children(std::size_t row) const -> Span<const int> {
+        return adjacent(m_child_offsets, m_child_rows, row);
+    }
+    auto parents(std::size_t row) const -> Span<const int> {
+        return adjacent(m_parent_offsets, m_parent_rows, row);
+    }
+    auto child_offsets() const -> Span<const int> { return m_child_offsets; }
+    auto child_rows() const -> Span<const int> { return m_child_rows; }
+    auto parent_offsets() const -> Span<const int> { return m_parent_offsets; }
+    auto parent_rows() const -> Span<const int> { return m_parent_rows; }
+
+    // id -> 行号，不存在时返回 -1
+    auto row_of(int id) const -> int {
+        auto it = m_index.find(id);
+        return it == m_index.end() ? -1 : it->second;
+    }
+    auto contains(int id) const -> bool { return row_of(id) >= 0; }
+
+    // 与旧接口之间的转换：按 id 升序构建，保证结果与哈希表遍历顺序无关
+    static auto from_map(const std::unordered_map<int, TaskRef> &tasks)
+        -> TaskTable;
+    auto to_task(std::size_t row) const -> TaskRef;
+    auto to_map() const -> std::unordered_map<int, TaskRef>;
+
+  private:
+    auto index_insert(int id, std::size_t row) -> void;
+    static auto adjacent(const vector<int> &offsets, const vector<int> &rows,
+                         std::size_t row) -> Span<const int> {
+        if (row + 1 >= offsets.size()) {
+            return {};
+        }
+        return Span<const int>(rows.data() + offsets[row],
+                               offsets[row + 1] - offsets[row]);
+    }
+
+    vector<int> m_id;
+    vector<int> m_clb;
+    vector<int> m_dsp;
+    vector<int> m_bram;
+    vector<int> m_exec;
+    vector<int> m_conf;
+
+    std::unordered_map<int, int> m_index; // id -> row
+
+    // CSR 邻接表，没有依赖关系时偏移数组为空
+    vector<int> m_child_offsets;
+    vector<int> m_child_rows;
+    vector<int> m_parent_offsets;
+    vector<int> m_parent_rows;
+};
+
+} // namespace seu
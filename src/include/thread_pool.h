@@ -0,0 +1,58 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace seu {
+
+// 固定大小的线程池
+// 1. submit 提交独立任务，返回 future
+// 2. parallel_for 把区间切成固定大小的块并行处理，调用线程也参与执行，
+//    因此可以在池内任务中嵌套调用而不会死锁
+class ThreadPool {
+  public:
+    // num_threads 为 0 时使用硬件线程数
+    explicit ThreadPool(std::size_t num_threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    auto size() const -> std::size_t { return m_workers.size(); }
+
+    template <typename F>
+    auto submit(F &&f) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using R = std::invoke_result_t<std::decay_t<F>>;
+        auto task =
+            std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+        auto future = task->get_future();
+        enqueue([task]() { (*task)(); });
+        return future;
+    }
+
+    // 对 [begin, end) 按 chunk_size 切块，fn(chunk_begin, chunk_end, chunk_id)
+    // 块的划分只取决于区间和 chunk_size，与线程数无关
+    auto parallel_for(
+        std::size_t begin, std::size_t end, std::size_t chunk_size,
+        const std::function<void(std::size_t, std::size_t, std::size_t)> &fn)
+        -> void;
+
+  private:
+    auto enqueue(std::function<void()> job) -> void;
+    auto worker_loop() -> void;
+
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stop = false;
+};
+
+} // namespace seu
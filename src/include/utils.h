@@ -3,13 +3,17 @@
 #include <limits.h>
 #include <string>
 #include <unistd.h>
+#include <vector>
 
 namespace seu {
 
 class Utils {
   public:
     static auto get_current_working_directory() -> std::string;
+    // 从当前目录向上查找 CMakeLists.txt 所在目录，结果在首次调用后缓存
     static auto get_project_root() -> std::string;
+    // 按 shell 通配规则展开 pattern，结果按字典序排列；没有匹配时为空
+    static auto glob(const std::string &pattern) -> std::vector<std::string>;
 };
 
 } // namespace seu
@@ -2,33 +2,207 @@
 #include "marco.h"
 #include "milp_solver_interface.h"
 #include "pynq/pynq_var.h"
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace seu {
 
-int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
-                                 vector<double> &slacks, bool preemptive_FRI,
-                                 pfsRef to_sim) {
-    int status;
+auto pynq_model_shape(const pynq_context &ctx, const Taskset &t,
+                      const Platform &platform, bool preemptive_FRI)
+    -> vector<long> {
+    vector<long> shape = {ctx.num_slots,
+                          ctx.num_forbidden_slots,
+                          ctx.num_rows,
+                          ctx.H,
+                          ctx.W,
+                          ctx.num_clk_regs,
+                          ctx.clb_per_tile,
+                          ctx.bram_per_tile,
+                          ctx.dsp_per_tile,
+                          ctx.num_conn_slots_pynq,
+                          (long)t.maxHW_Tasks,
+                          (long)t.maxSW_Tasks,
+                          (long)t.maxPartitions,
+                          (long)platform.N_FPGA_RESOURCES,
+                          preemptive_FRI,
+                          (long)ctx.formulation};
+    for (int i = 0; i < ctx.num_conn_slots_pynq; i++)
+        shape.insert(shape.end(), ctx.conn_matrix_pynq[i].begin(),
+                     ctx.conn_matrix_pynq[i].begin() + 3);
+    for (int i = 0; i < ctx.num_forbidden_slots; i++) {
+        const auto &fs = ctx.fs_pynq[i];
+        shape.insert(shape.end(), {fs.x, fs.y, fs.w, fs.h});
+    }
+    for (const auto &task : t.HW_Tasks)
+        shape.push_back(task.SW_Task_ID);
+    for (const auto &task : t.SW_Tasks) {
+        shape.push_back(-1);
+        shape.insert(shape.end(), task.H.begin(), task.H.end());
+    }
+    return shape;
+}
+
+auto pynq_breaks_symmetry(const pynq_context &ctx) -> bool {
+    return ctx.formulation == pynq_formulation::TIGHT &&
+           ctx.num_conn_slots_pynq == 0;
+}
+
+namespace {
+
+// con 7 / con 8 中的 BIG_M
+auto big_m_con7(const Taskset &t, const Platform &platform) -> double {
+    double big_m = 1;
+    for (uint x = 0; x < platform.N_FPGA_RESOURCES; x++)
+        big_m += platform.recTimePerUnit[x] * platform.maxFPGAResources[x];
+    for (uint b = 0; b < t.maxHW_Tasks; b++)
+        big_m += t.HW_Tasks[b].WCET;
+    return big_m;
+}
+
+// WEIGHTED 时为加权和；否则浪费的资源与布线长度为两个目标，priority 大的先
+// 优化；每次都清除上一次的多目标
+void set_objective(GRBModel &model, const milp_session_pynq &s,
+                   const pynq_objective &wt) {
+    GRBLinExpr wasted = s.obj_wasted_clb * wt.wasted_clb +
+                        s.obj_wasted_bram * wt.wasted_bram +
+                        s.obj_wasted_dsp * wt.wasted_dsp;
+    model.set(GRB_IntAttr_NumObj, 0);
+    if (wt.priority == pynq_priority::WEIGHTED) {
+        model.setObjective(wasted + s.obj_wirelength * wt.wirelength,
+                           GRB_MINIMIZE);
+        return;
+    }
+    const bool wasted_first = wt.priority == pynq_priority::WASTED_FIRST;
+    model.set(GRB_IntAttr_ModelSense, GRB_MINIMIZE);
+    model.setObjectiveN(wasted, 0, wasted_first ? 1 : 0, 1, 0, 0, "wasted");
+    model.setObjectiveN(s.obj_wirelength, 1, wasted_first ? 0 : 1, 1, 0, 0,
+                        "wirelength");
+}
+
+// 多目标时 ObjVal 只是 0 号目标（浪费的资源）的值，与优先级无关，
+// 因此按编号逐个读取 ObjNVal
+void read_objectives(GRBModel &model, pynq_context &ctx) {
+    ctx.objectives.clear();
+    if (ctx.weights.priority == pynq_priority::WEIGHTED) {
+        ctx.objective = model.get(GRB_DoubleAttr_ObjVal);
+        ctx.objectives.push_back(ctx.objective);
+        return;
+    }
+    for (int n = 0; n < 2; n++) {
+        model.set(GRB_IntParam_ObjNumber, n);
+        ctx.objectives.push_back(model.get(GRB_DoubleAttr_ObjNVal));
+    }
+    const bool wasted_first =
+        ctx.weights.priority == pynq_priority::WASTED_FIRST;
+    ctx.objective = ctx.objectives[wasted_first ? 0 : 1];
+}
+
+} // namespace
+
+void milp_session_pynq::clear() {
+    model.reset();
+    shape.clear();
+    for (auto *vars : {&A, &b, &I_SLOT, &DELTA, &DELTA_NP, &x, &clb, &bram,
+                       &dsp})
+        vars->clear();
+    for (auto *vars : {&gamma_part, &r, &y, &w, &h, &clb_fbdn_tot,
+                       &bram_fbdn_tot, &dsp_fbdn_tot})
+        vars->clear();
+    for (auto *constrs : {&con_total, &con_demand, &con_slot, &con_delta,
+                          &con_slack, &con_wirelength})
+        constrs->clear();
+    con_delta_task.clear();
+    start_vars.clear();
+    start_values.clear();
+}
+
+// 只记录决定布局的整数变量，其余变量由 Gurobi 在初始解的基础上补全
+void milp_session_pynq::save_incumbent() {
+    start_vars.clear();
+    for (const auto &row : A)
+        start_vars.insert(start_vars.end(), row.begin(), row.end());
+    for (const auto &row : x)
+        start_vars.insert(start_vars.end(), row.begin(), row.end());
+    for (const auto *vars : {&gamma_part, &y, &w, &h})
+        start_vars.insert(start_vars.end(), vars->begin(), vars->end());
+    start_values.resize(start_vars.size());
+    for (size_t i = 0; i < start_vars.size(); i++)
+        start_values[i] = start_vars[i].get(GRB_DoubleAttr_X);
+}
+
+void milp_session_pynq::warm_start() {
+    for (size_t i = 0; i < start_vars.size(); i++)
+        start_vars[i].set(GRB_DoubleAttr_Start, start_values[i]);
+}
+
+auto milp_solver_pynq::session() -> milp_session_pynq & {
+    if (!m_session)
+        m_session = std::make_shared<milp_session_pynq>();
+    return *m_session;
+}
+
+void milp_solver_pynq::build_model(milp_session_pynq &s, Taskset &t,
+                                   Platform &platform, vector<double> &slacks,
+                                   bool preemptive_FRI) {
     unsigned long i, k, j, l, m;
     unsigned long dist_0, dist_1, dist_2;
-    unsigned long num_active_partitions = 0;
 
-    // define variables
+    const int H = m_ctx.H, W = m_ctx.W;
+    const int num_slots = m_ctx.num_slots;
+    const int num_forbidden_slots = m_ctx.num_forbidden_slots;
+    const int num_clk_regs = m_ctx.num_clk_regs;
+    const int clb_per_tile = m_ctx.clb_per_tile;
+    const int bram_per_tile = m_ctx.bram_per_tile;
+    const int dsp_per_tile = m_ctx.dsp_per_tile;
+    const int num_conn_slots_pynq = m_ctx.num_conn_slots_pynq;
+    const auto &conn_matrix_pynq = m_ctx.conn_matrix_pynq;
+    const auto &fs_pynq = m_ctx.fs_pynq;
+
+    // 各约束族的 big-M，TIGHT 时由 W、H 与列数导出，LEGACY 时与原模型一致
+    // 1. 列计数 clb/bram/dsp[i][k] 及其 *_fbdn 是 x 的分段函数，不超过 W
+    // 2. M_col：z 的定义，分段端点都在 [0, W + 1] 内
+    // 3. M_cnt：列计数与分段值之差，分段的偏移不超过 11
+    // 4. tau_m：tau 的线性化，一个时钟区域内的列数之差不超过 W
+    // 5. M_res：分区中的资源，最多 W * num_clk_regs 个 tile
+    // 6. M_x / M_y：不重叠约束中坐标之差；M_edge：禁区边界
+    const bool tight = m_ctx.formulation == pynq_formulation::TIGHT;
+    const double col_clb = tight ? W : clb_max;
+    const double col_bram = tight ? W : bram_max;
+    const double col_dsp = tight ? W : dsp_max;
+    const double M_col = tight ? W + 1 : BIG_M;
+    const double M_cnt = tight ? 2 * (W + 1) : BIG_M;
+    const double M_x = tight ? W + 1 : BIG_M;
+    const double M_y = tight ? H + 1 : BIG_M;
+    double M_edge = BIG_M;
+    if (tight) {
+        M_edge = W;
+        for (auto edge : forbidden_boundaries_left)
+            M_edge = std::max<double>(M_edge, edge);
+        for (auto edge : forbidden_boundaries_right)
+            M_edge = std::max<double>(M_edge, edge);
+        M_edge += 1;
+    }
+    auto tau_m = [&](double legacy) { return tight ? W : legacy; };
+    auto M_res = [&](int per_tile) {
+        return tight ? (double)per_tile * W * num_clk_regs : (double)BIG_M;
+    };
+
+    s.clear();
+    // 构建出错时不在会话中留下构建了一半的模型
     try {
-        GRBEnv env = GRBEnv();
-        GRBConstr *c = NULL;
-        GRBModel model = GRBModel(env);
+        s.model = std::make_unique<GRBModel>(s.env);
+        GRBModel &model = *s.model;
 
-        if (num_slots >= num_forbidden_slots)
-            delta_size = num_slots;
-        else
-            delta_size = num_forbidden_slots;
+        const int delta_size = std::max(num_slots, num_forbidden_slots);
 
         // Variable definition
 
-        GRBVar2DArray b(platform.N_FPGA_RESOURCES);
+        GRBVar2DArray &b = s.b;
+        b.resize(platform.N_FPGA_RESOURCES);
         for (uint x = 0; x < platform.N_FPGA_RESOURCES; x++) {
             GRBVarArray per_partition(t.maxPartitions);
             b[x] = per_partition;
@@ -44,7 +218,8 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
         //          the the 'k'-th partition
         // ------------------------------------------------------------
 
-        GRBVar2DArray A(t.maxHW_Tasks);
+        GRBVar2DArray &A = s.A;
+        A.resize(t.maxHW_Tasks);
         for (uint a = 0; a < t.maxHW_Tasks; a++) {
             GRBVarArray per_partition(t.maxPartitions);
             A[a] = per_partition;
@@ -59,7 +234,8 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
         // Meaning: gamma[a]==1 iff the 'a'-th HW-task is subject to DPR
         // ------------------------------------------------------------
 
-        GRBVarArray gamma_part(t.maxHW_Tasks);
+        GRBVarArray &gamma_part = s.gamma_part;
+        gamma_part.resize(t.maxHW_Tasks);
         for (uint a = 0; a < t.maxHW_Tasks; a++) {
             gamma_part[a] = model.addVar(0.0, 1.0, 0.0, GRB_INTEGER);
         }
@@ -70,7 +246,8 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
         // to the 'a'-th HW-Task due to slot contention
         // ------------------------------------------------------------
 
-        GRBVar2DArray I_SLOT(t.maxHW_Tasks);
+        GRBVar2DArray &I_SLOT = s.I_SLOT;
+        I_SLOT.resize(t.maxHW_Tasks);
         for (uint a = 0; a < t.maxHW_Tasks; a++) {
             GRBVarArray per_other_HWTask(t.maxHW_Tasks);
             I_SLOT[a] = per_other_HWTask;
@@ -87,7 +264,8 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
         // by the 'i'-th SW-Task to the 'a'-th HW-Task
         // ------------------------------------------------------------
 
-        GRBVar2DArray DELTA(t.maxHW_Tasks);
+        GRBVar2DArray &DELTA = s.DELTA;
+        DELTA.resize(t.maxHW_Tasks);
         for (uint a = 0; a < t.maxHW_Tasks; a++) {
             GRBVarArray per_SWTask(t.maxSW_Tasks);
             DELTA[a] = per_SWTask;
@@ -103,7 +281,8 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
         // Meaning: r[a] = reconfiguration time of 'a'-th HW-Task
         // ------------------------------------------------------------
 
-        GRBVarArray r(t.maxHW_Tasks);
+        GRBVarArray &r = s.r;
+        r.resize(t.maxHW_Tasks);
         for (uint a = 0; a < t.maxHW_Tasks; a++) {
             r[a] = model.addVar(0.0, GRB_INFINITY, 0.0, GRB_CONTINUOUS);
         }
@@ -116,7 +295,8 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
         // during a request for the 'a'-th HW-Task
         // ------------------------------------------------------------
 
-        GRBVar2DArray DELTA_NP(t.maxHW_Tasks);
+        GRBVar2DArray &DELTA_NP = s.DELTA_NP;
+        DELTA_NP.resize(t.maxHW_Tasks);
         if (!preemptive_FRI) {
             for (uint a = 0; a < t.maxHW_Tasks; a++) {
                 GRBVarArray per_other_HWTask(t.maxHW_Tasks);
@@ -134,7 +314,8 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
          func: x[i][k] represent the left and right x coordinate of slot 'i'
         ***********************************************************************/
 
-        GRBVar2DArray x(num_slots);
+        GRBVar2DArray &x = s.x;
+        x.resize(num_slots);
         for (i = 0; i < (uint)num_slots; i++) {
             GRBVarArray each_slot(2);
             x[i] = each_slot;
@@ -149,7 +330,8 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
          func: y[i] represents the bottom left y coordinate of slot 'i'
         ***********************************************************************/
 
-        GRBVarArray y(num_slots);
+        GRBVarArray &y = s.y;
+        y.resize(num_slots);
         for (i = 0; i < (uint)num_slots; i++) {
             y[i] = model.addVar(0.0, num_clk_regs, 0.0, GRB_INTEGER);
         }
@@ -160,7 +342,8 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
          func: w[i] represents the width of the slot 'i'
         ***********************************************************************/
 
-        GRBVarArray w(num_slots);
+        GRBVarArray &w = s.w;
+        w.resize(num_slots);
         for (i = 0; i < (uint)num_slots; i++) {
             w[i] = model.addVar(0.0, W, 0.0, GRB_INTEGER);
         }
@@ -171,7 +354,8 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
          func: h[i] represents the height of slot 'i'
         ***********************************************************************/
 
-        GRBVarArray h(num_slots);
+        GRBVarArray &h = s.h;
+        h.resize(num_slots);
         for (i = 0; i < (uint)num_slots; i++) {
             h[i] = model.addVar(0.0, H, 0.0, GRB_INTEGER);
         }
@@ -217,13 +401,14 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                  clb in 'i' = clb[i][1] - clb[i][0]
          ***********************************************************************/
 
-        GRBVar2DArray clb(num_slots);
+        GRBVar2DArray &clb = s.clb;
+        clb.resize(num_slots);
         for (i = 0; i < (uint)num_slots; i++) {
             GRBVarArray each_slot(2);
             clb[i] = each_slot;
 
             for (k = 0; k < 2; k++)
-                clb[i][k] = model.addVar(0.0, clb_max, 0.0, GRB_INTEGER);
+                clb[i][k] = model.addVar(0.0, col_clb, 0.0, GRB_INTEGER);
         }
 
         /**********************************************************************
@@ -238,13 +423,14 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                  bram in 'i' = bram[i][1] - bram[i][0]
          ***********************************************************************/
 
-        GRBVar2DArray bram(num_slots);
+        GRBVar2DArray &bram = s.bram;
+        bram.resize(num_slots);
         for (i = 0; i < (uint)num_slots; i++) {
             GRBVarArray each_slot(2);
             bram[i] = each_slot;
 
             for (k = 0; k < 2; k++)
-                bram[i][k] = model.addVar(0.0, bram_max, 0.0, GRB_INTEGER);
+                bram[i][k] = model.addVar(0.0, col_bram, 0.0, GRB_INTEGER);
         }
 
         /**********************************************************************
@@ -259,13 +445,14 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                 dsp in 'i' = dsp[i][1] - dsp[i][0]
         ***********************************************************************/
 
-        GRBVar2DArray dsp(num_slots);
+        GRBVar2DArray &dsp = s.dsp;
+        dsp.resize(num_slots);
         for (i = 0; i < (uint)num_slots; i++) {
             GRBVarArray each_slot(2);
             dsp[i] = each_slot;
 
             for (k = 0; k < 2; k++)
-                dsp[i][k] = model.addVar(0.0, dsp_max, 0.0, GRB_INTEGER);
+                dsp[i][k] = model.addVar(0.0, col_dsp, 0.0, GRB_INTEGER);
         }
 
         /**********************************************************************
@@ -289,7 +476,7 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                 clb_fbdn[i][j] = each_slot_fbdn;
                 for (k = 0; k < 2; k++)
                     clb_fbdn[i][j][k] =
-                        model.addVar(0.0, clb_max, 0.0, GRB_INTEGER);
+                        model.addVar(0.0, col_clb, 0.0, GRB_INTEGER);
             }
         }
 
@@ -298,17 +485,20 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
         in forbidden regions.
         ***********************************************************************/
 
-        GRBVarArray clb_fbdn_tot(num_slots);
+        GRBVarArray &clb_fbdn_tot = s.clb_fbdn_tot;
+        clb_fbdn_tot.resize(num_slots);
         for (i = 0; i < (uint)num_slots; i++) {
             clb_fbdn_tot[i] = model.addVar(0, clb_max, 0.0, GRB_INTEGER);
         }
 
-        GRBVarArray bram_fbdn_tot(num_slots);
+        GRBVarArray &bram_fbdn_tot = s.bram_fbdn_tot;
+        bram_fbdn_tot.resize(num_slots);
         for (i = 0; i < (uint)num_slots; i++) {
             bram_fbdn_tot[i] = model.addVar(0, bram_max, 0.0, GRB_INTEGER);
         }
 
-        GRBVarArray dsp_fbdn_tot(num_slots);
+        GRBVarArray &dsp_fbdn_tot = s.dsp_fbdn_tot;
+        dsp_fbdn_tot.resize(num_slots);
         for (i = 0; i < (uint)num_slots; i++) {
             dsp_fbdn_tot[i] = model.addVar(0, dsp_max, 0.0, GRB_INTEGER);
         }
@@ -335,7 +525,7 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
 
                 for (k = 0; k < 2; k++)
                     bram_fbdn[j][i][k] =
-                        model.addVar(0.0, bram_max, 0.0, GRB_INTEGER);
+                        model.addVar(0.0, col_bram, 0.0, GRB_INTEGER);
             }
         }
         /**********************************************************************
@@ -358,7 +548,7 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
 
                 for (k = 0; k < 2; k++)
                     dsp_fbdn[j][i][k] =
-                        model.addVar(0.0, dsp_max, 0.0, GRB_INTEGER);
+                        model.addVar(0.0, col_dsp, 0.0, GRB_INTEGER);
             }
         }
         // #endif
@@ -765,8 +955,8 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (uint k = 0; k < t.maxPartitions; k++)
                 exp += b[x][k];
 
-            model.addConstr(exp <= (double)platform.maxFPGAResources[x],
-                            "con 3");
+            s.con_total.push_back(model.addConstr(
+                exp <= (double)platform.maxFPGAResources[x], "con 3"));
         }
 
         /********************************************************************
@@ -778,9 +968,9 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (uint k = 0; k < t.maxPartitions; k++) {
                 GRBLinExpr exp;
                 for (uint a = 0; a < t.maxHW_Tasks; a++) {
-                    model.addConstr(
+                    s.con_demand.push_back(model.addConstr(
                         b[x][k] >= (double)t.HW_Tasks[a].resDemand[x] * A[a][k],
-                        "con 4");
+                        "con 4"));
                     exp += A[a][k];
                 }
                 // model.addConstr(b[x][k] <= (double)BIG_M * exp, "con 11");
@@ -822,22 +1012,17 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
 
                     const double WCET = (double)t.HW_Tasks[b].WCET;
 
-                    model.addConstr(I_SLOT[a][b] >= WCET -
-                                                        WCET * (1 - A[a][k]) -
-                                                        WCET * (1 - A[b][k]),
-                                    "con 7");
+                    s.con_slot.push_back(model.addConstr(
+                        I_SLOT[a][b] >= WCET - WCET * (1 - A[a][k]) -
+                                            WCET * (1 - A[b][k]),
+                        "con 7"));
                 }
 
         /********************************************************************
          Constraint 0.7: Bound on delay incurred when requesting a HW-Task
         ***********************************************************************/
 
-        double BIG_M_con7 = 1;
-        for (uint x = 0; x < platform.N_FPGA_RESOURCES; x++)
-            BIG_M_con7 +=
-                platform.recTimePerUnit[x] * platform.maxFPGAResources[x];
-        for (uint b = 0; b < t.maxHW_Tasks; b++)
-            BIG_M_con7 += t.HW_Tasks[b].WCET;
+        const double BIG_M_con7 = big_m_con7(t, platform);
 
         for (uint a = 0; a < t.maxHW_Tasks; a++) {
             for (uint i = 0; i < t.maxSW_Tasks; i++) {
@@ -846,11 +1031,13 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                     continue;
 
                 // For each HW-task used by the 'i'-th SW-task...
-                for (auto b : t.SW_Tasks[i].H)
-                    model.addConstr(DELTA[a][i] >=
-                                        I_SLOT[a][b] + r[b] -
-                                            (1 - gamma_part[a]) * BIG_M_con7,
-                                    "con 8");
+                for (auto b : t.SW_Tasks[i].H) {
+                    s.con_delta.push_back(model.addConstr(
+                        DELTA[a][i] >= I_SLOT[a][b] + r[b] -
+                                           (1 - gamma_part[a]) * BIG_M_con7,
+                        "con 8"));
+                    s.con_delta_task.push_back(a);
+                }
             }
         }
 
@@ -879,7 +1066,7 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                 }
             }
 
-            model.addConstr(exp <= slacks[i], "con 9");
+            s.con_slack.push_back(model.addConstr(exp <= slacks[i], "con 9"));
         }
 
         /********************************************************************
@@ -911,6 +1098,13 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             model.addConstr(x[i][1] - x[i][0] >= 1, "4");
         }
 
+        // 槽之间可以互换（分配矩阵 A 的列随之互换），TIGHT 时按 x[i][0] 排序以
+        // 消除对称解；布线长度与槽的编号有关，有连接关系时不排序
+        if (pynq_breaks_symmetry(m_ctx)) {
+            for (i = 0; i + 1 < (uint)num_slots; i++)
+                model.addConstr(x[i][0] <= x[i + 1][0], "sym");
+        }
+
         /********************************************************************
         Constr 1.2: The binary variables representing the rows must be
                     contigious i.e, if a region occupies clock region 1 and 3
@@ -968,29 +1162,29 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (k = 0; k < 2; k++) {
                 l = 0;
                 GRBLinExpr exp;
-                model.addConstr(BIG_M * z[0][i][k][l++] >= 5 - x[i][k], "1");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= x[i][k] - 4, "2");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= 8 - x[i][k], "3");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= x[i][k] - 7, "4");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= 13 - x[i][k], "5");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= x[i][k] - 12, "6");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= 16 - x[i][k], "7");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= x[i][k] - 15, "8");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= 21 - x[i][k], "9");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= x[i][k] - 20, "10");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= 24 - x[i][k], "11");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= x[i][k] - 23, "12");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= 35 - x[i][k], "13");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= x[i][k] - 34, "14");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= 55 - x[i][k], "7");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= x[i][k] - 54, "8");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= 58 - x[i][k], "9");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= x[i][k] - 57, "10");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= 63 - x[i][k], "11");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= x[i][k] - 62, "12");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= 66 - x[i][k], "13");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= x[i][k] - 65, "14");
-                model.addConstr(BIG_M * z[0][i][k][l++] >= W + 1 - x[i][k],
+                model.addConstr(M_col * z[0][i][k][l++] >= 5 - x[i][k], "1");
+                model.addConstr(M_col * z[0][i][k][l++] >= x[i][k] - 4, "2");
+                model.addConstr(M_col * z[0][i][k][l++] >= 8 - x[i][k], "3");
+                model.addConstr(M_col * z[0][i][k][l++] >= x[i][k] - 7, "4");
+                model.addConstr(M_col * z[0][i][k][l++] >= 13 - x[i][k], "5");
+                model.addConstr(M_col * z[0][i][k][l++] >= x[i][k] - 12, "6");
+                model.addConstr(M_col * z[0][i][k][l++] >= 16 - x[i][k], "7");
+                model.addConstr(M_col * z[0][i][k][l++] >= x[i][k] - 15, "8");
+                model.addConstr(M_col * z[0][i][k][l++] >= 21 - x[i][k], "9");
+                model.addConstr(M_col * z[0][i][k][l++] >= x[i][k] - 20, "10");
+                model.addConstr(M_col * z[0][i][k][l++] >= 24 - x[i][k], "11");
+                model.addConstr(M_col * z[0][i][k][l++] >= x[i][k] - 23, "12");
+                model.addConstr(M_col * z[0][i][k][l++] >= 35 - x[i][k], "13");
+                model.addConstr(M_col * z[0][i][k][l++] >= x[i][k] - 34, "14");
+                model.addConstr(M_col * z[0][i][k][l++] >= 55 - x[i][k], "7");
+                model.addConstr(M_col * z[0][i][k][l++] >= x[i][k] - 54, "8");
+                model.addConstr(M_col * z[0][i][k][l++] >= 58 - x[i][k], "9");
+                model.addConstr(M_col * z[0][i][k][l++] >= x[i][k] - 57, "10");
+                model.addConstr(M_col * z[0][i][k][l++] >= 63 - x[i][k], "11");
+                model.addConstr(M_col * z[0][i][k][l++] >= x[i][k] - 62, "12");
+                model.addConstr(M_col * z[0][i][k][l++] >= 66 - x[i][k], "13");
+                model.addConstr(M_col * z[0][i][k][l++] >= x[i][k] - 65, "14");
+                model.addConstr(M_col * z[0][i][k][l++] >= W + 1 - x[i][k],
                                 "15");
 
                 for (m = 0; m < l; m++)
@@ -1005,61 +1199,61 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (k = 0; k < 2; k++) {
                 l = 0;
                 model.addConstr(
-                    clb[i][k] >= x[i][k] - BIG_M * (1 - z[0][i][k][l]), "8");
+                    clb[i][k] >= x[i][k] - M_cnt * (1 - z[0][i][k][l]), "8");
                 l++;
                 model.addConstr(
-                    clb[i][k] >= (x[i][k] - 1) - BIG_M * (1 - z[0][i][k][l]) -
-                                     BIG_M * (1 - z[0][i][k][l + 1]),
+                    clb[i][k] >= (x[i][k] - 1) - M_cnt * (1 - z[0][i][k][l]) -
+                                     M_cnt * (1 - z[0][i][k][l + 1]),
                     "9");
                 l += 2;
                 model.addConstr(
-                    clb[i][k] >= (x[i][k] - 2) - BIG_M * (1 - z[0][i][k][l]) -
-                                     BIG_M * (1 - z[0][i][k][l + 1]),
+                    clb[i][k] >= (x[i][k] - 2) - M_cnt * (1 - z[0][i][k][l]) -
+                                     M_cnt * (1 - z[0][i][k][l + 1]),
                     "10");
                 l += 2;
                 model.addConstr(
-                    clb[i][k] >= (x[i][k] - 3) - BIG_M * (1 - z[0][i][k][l]) -
-                                     BIG_M * (1 - z[0][i][k][l + 1]),
+                    clb[i][k] >= (x[i][k] - 3) - M_cnt * (1 - z[0][i][k][l]) -
+                                     M_cnt * (1 - z[0][i][k][l + 1]),
                     "11");
                 l += 2;
                 model.addConstr(
-                    clb[i][k] >= (x[i][k] - 4) - BIG_M * (1 - z[0][i][k][l]) -
-                                     BIG_M * (1 - z[0][i][k][l + 1]),
+                    clb[i][k] >= (x[i][k] - 4) - M_cnt * (1 - z[0][i][k][l]) -
+                                     M_cnt * (1 - z[0][i][k][l + 1]),
                     "12");
                 l += 2;
                 model.addConstr(
-                    clb[i][k] >= (x[i][k] - 5) - BIG_M * (1 - z[0][i][k][l]) -
-                                     BIG_M * (1 - z[0][i][k][l + 1]),
+                    clb[i][k] >= (x[i][k] - 5) - M_cnt * (1 - z[0][i][k][l]) -
+                                     M_cnt * (1 - z[0][i][k][l + 1]),
                     "13");
                 l += 2;
                 model.addConstr(
-                    clb[i][k] >= (x[i][k] - 6) - BIG_M * (1 - z[0][i][k][l]) -
-                                     BIG_M * (1 - z[0][i][k][l + 1]),
+                    clb[i][k] >= (x[i][k] - 6) - M_cnt * (1 - z[0][i][k][l]) -
+                                     M_cnt * (1 - z[0][i][k][l + 1]),
                     "14");
                 l += 2;
                 model.addConstr(
-                    clb[i][k] >= (x[i][k] - 7) - BIG_M * (1 - z[0][i][k][l]) -
-                                     BIG_M * (1 - z[0][i][k][l + 1]),
+                    clb[i][k] >= (x[i][k] - 7) - M_cnt * (1 - z[0][i][k][l]) -
+                                     M_cnt * (1 - z[0][i][k][l + 1]),
                     "15");
                 l += 2;
                 model.addConstr(
-                    clb[i][k] >= (x[i][k] - 8) - BIG_M * (1 - z[0][i][k][l]) -
-                                     BIG_M * (1 - z[0][i][k][l + 1]),
+                    clb[i][k] >= (x[i][k] - 8) - M_cnt * (1 - z[0][i][k][l]) -
+                                     M_cnt * (1 - z[0][i][k][l + 1]),
                     "12");
                 l += 2;
                 model.addConstr(
-                    clb[i][k] >= (x[i][k] - 9) - BIG_M * (1 - z[0][i][k][l]) -
-                                     BIG_M * (1 - z[0][i][k][l + 1]),
+                    clb[i][k] >= (x[i][k] - 9) - M_cnt * (1 - z[0][i][k][l]) -
+                                     M_cnt * (1 - z[0][i][k][l + 1]),
                     "13");
                 l += 2;
                 model.addConstr(
-                    clb[i][k] >= (x[i][k] - 10) - BIG_M * (1 - z[0][i][k][l]) -
-                                     BIG_M * (1 - z[0][i][k][l + 1]),
+                    clb[i][k] >= (x[i][k] - 10) - M_cnt * (1 - z[0][i][k][l]) -
+                                     M_cnt * (1 - z[0][i][k][l + 1]),
                     "14");
                 l += 2;
                 model.addConstr(
-                    clb[i][k] >= (x[i][k] - 11) - BIG_M * (1 - z[0][i][k][l]) -
-                                     BIG_M * (1 - z[0][i][k][l + 1]),
+                    clb[i][k] >= (x[i][k] - 11) - M_cnt * (1 - z[0][i][k][l]) -
+                                     M_cnt * (1 - z[0][i][k][l + 1]),
                     "15");
                 l += 2;
             }
@@ -1067,61 +1261,61 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (k = 0; k < 2; k++) {
                 l = 0;
                 model.addConstr(
-                    x[i][k] >= clb[i][k] - BIG_M * (1 - z[0][i][k][l]), "16");
+                    x[i][k] >= clb[i][k] - M_cnt * (1 - z[0][i][k][l]), "16");
                 l++;
                 model.addConstr(x[i][k] - 1 >=
-                                    (clb[i][k]) - BIG_M * (1 - z[0][i][k][l]) -
-                                        BIG_M * (1 - z[0][i][k][l + 1]),
+                                    (clb[i][k]) - M_cnt * (1 - z[0][i][k][l]) -
+                                        M_cnt * (1 - z[0][i][k][l + 1]),
                                 "17");
                 l += 2;
                 model.addConstr(x[i][k] - 2 >=
-                                    (clb[i][k]) - BIG_M * (1 - z[0][i][k][l]) -
-                                        BIG_M * (1 - z[0][i][k][l + 1]),
+                                    (clb[i][k]) - M_cnt * (1 - z[0][i][k][l]) -
+                                        M_cnt * (1 - z[0][i][k][l + 1]),
                                 "18");
                 l += 2;
                 model.addConstr(x[i][k] - 3 >=
-                                    (clb[i][k]) - BIG_M * (1 - z[0][i][k][l]) -
-                                        BIG_M * (1 - z[0][i][k][l + 1]),
+                                    (clb[i][k]) - M_cnt * (1 - z[0][i][k][l]) -
+                                        M_cnt * (1 - z[0][i][k][l + 1]),
                                 "19");
                 l += 2;
                 model.addConstr(x[i][k] - 4 >=
-                                    (clb[i][k]) - BIG_M * (1 - z[0][i][k][l]) -
-                                        BIG_M * (1 - z[0][i][k][l + 1]),
+                                    (clb[i][k]) - M_cnt * (1 - z[0][i][k][l]) -
+                                        M_cnt * (1 - z[0][i][k][l + 1]),
                                 "20");
                 l += 2;
                 model.addConstr(x[i][k] - 5 >=
-                                    (clb[i][k]) - BIG_M * (1 - z[0][i][k][l]) -
-                                        BIG_M * (1 - z[0][i][k][l + 1]),
+                                    (clb[i][k]) - M_cnt * (1 - z[0][i][k][l]) -
+                                        M_cnt * (1 - z[0][i][k][l + 1]),
                                 "21");
                 l += 2;
                 model.addConstr(x[i][k] - 6 >=
-                                    (clb[i][k]) - BIG_M * (1 - z[0][i][k][l]) -
-                                        BIG_M * (1 - z[0][i][k][l + 1]),
+                                    (clb[i][k]) - M_cnt * (1 - z[0][i][k][l]) -
+                                        M_cnt * (1 - z[0][i][k][l + 1]),
                                 "22");
                 l += 2;
                 model.addConstr(x[i][k] - 7 >=
-                                    (clb[i][k]) - BIG_M * (1 - z[0][i][k][l]) -
-                                        BIG_M * (1 - z[0][i][k][l + 1]),
+                                    (clb[i][k]) - M_cnt * (1 - z[0][i][k][l]) -
+                                        M_cnt * (1 - z[0][i][k][l + 1]),
                                 "23");
                 l += 2;
                 model.addConstr(x[i][k] - 8 >=
-                                    (clb[i][k]) - BIG_M * (1 - z[0][i][k][l]) -
-                                        BIG_M * (1 - z[0][i][k][l + 1]),
+                                    (clb[i][k]) - M_cnt * (1 - z[0][i][k][l]) -
+                                        M_cnt * (1 - z[0][i][k][l + 1]),
                                 "20");
                 l += 2;
                 model.addConstr(x[i][k] - 9 >=
-                                    (clb[i][k]) - BIG_M * (1 - z[0][i][k][l]) -
-                                        BIG_M * (1 - z[0][i][k][l + 1]),
+                                    (clb[i][k]) - M_cnt * (1 - z[0][i][k][l]) -
+                                        M_cnt * (1 - z[0][i][k][l + 1]),
                                 "21");
                 l += 2;
                 model.addConstr(x[i][k] - 10 >=
-                                    (clb[i][k]) - BIG_M * (1 - z[0][i][k][l]) -
-                                        BIG_M * (1 - z[0][i][k][l + 1]),
+                                    (clb[i][k]) - M_cnt * (1 - z[0][i][k][l]) -
+                                        M_cnt * (1 - z[0][i][k][l + 1]),
                                 "22");
                 l += 2;
                 model.addConstr(x[i][k] - 11 >=
-                                    (clb[i][k]) - BIG_M * (1 - z[0][i][k][l]) -
-                                        BIG_M * (1 - z[0][i][k][l + 1]),
+                                    (clb[i][k]) - M_cnt * (1 - z[0][i][k][l]) -
+                                        M_cnt * (1 - z[0][i][k][l + 1]),
                                 "23");
                 l += 2;
             }
@@ -1144,15 +1338,15 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                 l = 0;
                 // FBDN region one
                 GRBLinExpr exp;
-                model.addConstr(BIG_M * z[3][i][k][l++] >= 5 - x[i][k], "1");
-                model.addConstr(BIG_M * z[3][i][k][l++] >= x[i][k] - 4, "2");
-                model.addConstr(BIG_M * z[3][i][k][l++] >= 8 - x[i][k], "3");
-                model.addConstr(BIG_M * z[3][i][k][l++] >= x[i][k] - 7, "4");
-                model.addConstr(BIG_M * z[3][i][k][l++] >= 13 - x[i][k], "5");
-                model.addConstr(BIG_M * z[3][i][k][l++] >= x[i][k] - 12, "6");
-                model.addConstr(BIG_M * z[3][i][k][l++] >= 16 - x[i][k], "7");
-                model.addConstr(BIG_M * z[3][i][k][l++] >= x[i][k] - 15, "8");
-                model.addConstr(BIG_M * z[3][i][k][l++] >= W + 1 - x[i][k],
+                model.addConstr(M_col * z[3][i][k][l++] >= 5 - x[i][k], "1");
+                model.addConstr(M_col * z[3][i][k][l++] >= x[i][k] - 4, "2");
+                model.addConstr(M_col * z[3][i][k][l++] >= 8 - x[i][k], "3");
+                model.addConstr(M_col * z[3][i][k][l++] >= x[i][k] - 7, "4");
+                model.addConstr(M_col * z[3][i][k][l++] >= 13 - x[i][k], "5");
+                model.addConstr(M_col * z[3][i][k][l++] >= x[i][k] - 12, "6");
+                model.addConstr(M_col * z[3][i][k][l++] >= 16 - x[i][k], "7");
+                model.addConstr(M_col * z[3][i][k][l++] >= x[i][k] - 15, "8");
+                model.addConstr(M_col * z[3][i][k][l++] >= W + 1 - x[i][k],
                                 "9");
                 for (m = 0; m < l; m++)
                     exp += z[3][i][k][m];
@@ -1162,11 +1356,11 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                 // FBDN region 2
                 GRBLinExpr exp_2;
                 m = l - 1;
-                model.addConstr(BIG_M * z[3][i][k][l++] >= 43 - x[i][k], "7");
-                model.addConstr(BIG_M * z[3][i][k][l++] >= x[i][k] - 42, "14");
-                model.addConstr(BIG_M * z[3][i][k][l++] >= 50 - x[i][k], "14");
-                model.addConstr(BIG_M * z[3][i][k][l++] >= x[i][k] - 49, "14");
-                model.addConstr(BIG_M * z[3][i][k][l++] >= W + 1 - x[i][k],
+                model.addConstr(M_col * z[3][i][k][l++] >= 43 - x[i][k], "7");
+                model.addConstr(M_col * z[3][i][k][l++] >= x[i][k] - 42, "14");
+                model.addConstr(M_col * z[3][i][k][l++] >= 50 - x[i][k], "14");
+                model.addConstr(M_col * z[3][i][k][l++] >= x[i][k] - 49, "14");
+                model.addConstr(M_col * z[3][i][k][l++] >= W + 1 - x[i][k],
                                 "15");
 
                 for (; m < l; m++)
@@ -1182,54 +1376,54 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
 
                 // FBDN region one
                 model.addConstr(clb_fbdn[0][i][k] >=
-                                    x[i][k] - BIG_M * (1 - z[3][i][k][l++]),
+                                    x[i][k] - M_cnt * (1 - z[3][i][k][l++]),
                                 "8");
 
                 model.addConstr(clb_fbdn[0][i][k] >=
                                     (x[i][k] - 1) -
-                                        BIG_M * (1 - z[3][i][k][l]) -
-                                        BIG_M * (1 - z[3][i][k][l + 1]),
+                                        M_cnt * (1 - z[3][i][k][l]) -
+                                        M_cnt * (1 - z[3][i][k][l + 1]),
                                 "9");
                 l += 2;
 
                 model.addConstr(clb_fbdn[0][i][k] >=
                                     (x[i][k] - 2) -
-                                        BIG_M * (1 - z[3][i][k][l]) -
-                                        BIG_M * (1 - z[3][i][k][l + 1]),
+                                        M_cnt * (1 - z[3][i][k][l]) -
+                                        M_cnt * (1 - z[3][i][k][l + 1]),
                                 "10");
 
                 l += 2;
                 model.addConstr(clb_fbdn[0][i][k] >=
                                     (x[i][k] - 3) -
-                                        BIG_M * (1 - z[3][i][k][l]) -
-                                        BIG_M * (1 - z[3][i][k][l + 1]),
+                                        M_cnt * (1 - z[3][i][k][l]) -
+                                        M_cnt * (1 - z[3][i][k][l + 1]),
                                 "11");
 
                 l += 2;
                 model.addConstr(clb_fbdn[0][i][k] >=
                                     (fs_pynq[0].x + fs_pynq[0].w - 4) -
-                                        BIG_M * (1 - z[3][i][k][l]) -
-                                        BIG_M * (1 - z[3][i][k][l + 1]),
+                                        M_cnt * (1 - z[3][i][k][l]) -
+                                        M_cnt * (1 - z[3][i][k][l + 1]),
                                 "12");
 
                 l += 2;
                 // FBDN region two
                 model.addConstr(clb_fbdn[1][i][k] >=
-                                    35 - BIG_M * (1 - z[3][i][k][l++]),
+                                    35 - M_cnt * (1 - z[3][i][k][l++]),
                                 "8"); // fs_pynq[1].x - 7
 
                 model.addConstr(clb_fbdn[1][i][k] >=
                                     (x[i][k] - 7) -
-                                        BIG_M * (1 - z[3][i][k][l]) -
-                                        BIG_M * (1 - z[3][i][k][l + 1]),
+                                        M_cnt * (1 - z[3][i][k][l]) -
+                                        M_cnt * (1 - z[3][i][k][l + 1]),
                                 "9");
                 l += 2;
 
                 model.addConstr(
                     clb_fbdn[1][i][k] >=
-                        41 - BIG_M * (1 - z[3][i][k][l]) - // fs_pynq[1].x +
+                        41 - M_cnt * (1 - z[3][i][k][l]) - // fs_pynq[1].x +
                                                            // fs_pynq[1]. w - 7
-                            BIG_M * (1 - z[3][i][k][l + 1]),
+                            M_cnt * (1 - z[3][i][k][l + 1]),
                     "10");
             }
 
@@ -1238,51 +1432,51 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
 
                 // FBDN region one
                 model.addConstr(x[i][k] >= clb_fbdn[0][i][k] -
-                                               BIG_M * (1 - z[3][i][k][l++]),
+                                               M_cnt * (1 - z[3][i][k][l++]),
                                 "16");
 
                 model.addConstr(x[i][k] - 1 >=
                                     (clb_fbdn[0][i][k]) -
-                                        BIG_M * (1 - z[3][i][k][l]) -
-                                        BIG_M * (1 - z[3][i][k][l + 1]),
+                                        M_cnt * (1 - z[3][i][k][l]) -
+                                        M_cnt * (1 - z[3][i][k][l + 1]),
                                 "17");
                 l += 2;
 
                 model.addConstr(x[i][k] - 2 >=
                                     (clb_fbdn[0][i][k]) -
-                                        BIG_M * (1 - z[3][i][k][l]) -
-                                        BIG_M * (1 - z[3][i][k][l + 1]),
+                                        M_cnt * (1 - z[3][i][k][l]) -
+                                        M_cnt * (1 - z[3][i][k][l + 1]),
                                 "18");
                 l += 2;
 
                 model.addConstr(x[i][k] - 3 >=
                                     (clb_fbdn[0][i][k]) -
-                                        BIG_M * (1 - z[3][i][k][l]) -
-                                        BIG_M * (1 - z[3][i][k][l + 1]),
+                                        M_cnt * (1 - z[3][i][k][l]) -
+                                        M_cnt * (1 - z[3][i][k][l + 1]),
                                 "19");
                 l += 2;
-                model.addConstr(fs_pynq[i].x + fs_pynq[i].w - 4 >=
+                model.addConstr(fs_pynq[0].x + fs_pynq[0].w - 4 >=
                                     (clb_fbdn[0][i][k]) -
-                                        BIG_M * (1 - z[3][i][k][l]) -
-                                        BIG_M * (1 - z[3][i][k][l + 1]),
+                                        M_cnt * (1 - z[3][i][k][l]) -
+                                        M_cnt * (1 - z[3][i][k][l + 1]),
                                 "20");
                 l += 2;
                 // FBDN region two
                 model.addConstr(35 >= clb_fbdn[1][i][k] -
-                                          BIG_M * (1 - z[3][i][k][l++]),
+                                          M_cnt * (1 - z[3][i][k][l++]),
                                 "8"); // fs_pynq[1].x - 7
 
                 model.addConstr((x[i][k] - 7) >=
                                     clb_fbdn[1][i][k] -
-                                        BIG_M * (1 - z[3][i][k][l]) -
-                                        BIG_M * (1 - z[3][i][k][l + 1]),
+                                        M_cnt * (1 - z[3][i][k][l]) -
+                                        M_cnt * (1 - z[3][i][k][l + 1]),
                                 "9");
                 l += 2;
                 model.addConstr(
                     41 >= clb_fbdn[1][i][k] -
-                              BIG_M * (1 - z[3][i][k][l]) - // fs_pynq[1].x +
+                              M_cnt * (1 - z[3][i][k][l]) - // fs_pynq[1].x +
                                                             // fs_pynq[1]. w - 7
-                              BIG_M * (1 - z[3][i][k][l + 1]),
+                              M_cnt * (1 - z[3][i][k][l + 1]),
                     "10");
             }
         }
@@ -1303,19 +1497,19 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (k = 0; k < 2; k++) {
                 l = 0;
                 GRBLinExpr exp;
-                model.addConstr(BIG_M * z[1][i][k][l++] >= 5 - x[i][k], "32");
-                model.addConstr(BIG_M * z[1][i][k][l++] >= x[i][k] - 4, "33");
-                model.addConstr(BIG_M * z[1][i][k][l++] >= 16 - x[i][k], "34");
-                model.addConstr(BIG_M * z[1][i][k][l++] >= x[i][k] - 15, "35");
-                model.addConstr(BIG_M * z[1][i][k][l++] >= 21 - x[i][k], "36");
-                model.addConstr(BIG_M * z[1][i][k][l++] >= x[i][k] - 20, "37");
-                model.addConstr(BIG_M * z[1][i][k][l++] >= 35 - x[i][k], "34");
-                model.addConstr(BIG_M * z[1][i][k][l++] >= x[i][k] - 34, "35");
-                model.addConstr(BIG_M * z[1][i][k][l++] >= 55 - x[i][k], "36");
-                model.addConstr(BIG_M * z[1][i][k][l++] >= x[i][k] - 54, "37");
-                model.addConstr(BIG_M * z[1][i][k][l++] >= 66 - x[i][k], "34");
-                model.addConstr(BIG_M * z[1][i][k][l++] >= x[i][k] - 65, "35");
-                model.addConstr(BIG_M * z[1][i][k][l++] >= W + 1 - x[i][k],
+                model.addConstr(M_col * z[1][i][k][l++] >= 5 - x[i][k], "32");
+                model.addConstr(M_col * z[1][i][k][l++] >= x[i][k] - 4, "33");
+                model.addConstr(M_col * z[1][i][k][l++] >= 16 - x[i][k], "34");
+                model.addConstr(M_col * z[1][i][k][l++] >= x[i][k] - 15, "35");
+                model.addConstr(M_col * z[1][i][k][l++] >= 21 - x[i][k], "36");
+                model.addConstr(M_col * z[1][i][k][l++] >= x[i][k] - 20, "37");
+                model.addConstr(M_col * z[1][i][k][l++] >= 35 - x[i][k], "34");
+                model.addConstr(M_col * z[1][i][k][l++] >= x[i][k] - 34, "35");
+                model.addConstr(M_col * z[1][i][k][l++] >= 55 - x[i][k], "36");
+                model.addConstr(M_col * z[1][i][k][l++] >= x[i][k] - 54, "37");
+                model.addConstr(M_col * z[1][i][k][l++] >= 66 - x[i][k], "34");
+                model.addConstr(M_col * z[1][i][k][l++] >= x[i][k] - 65, "35");
+                model.addConstr(M_col * z[1][i][k][l++] >= W + 1 - x[i][k],
                                 "38");
 
                 for (m = 0; m < l; m++)
@@ -1328,83 +1522,83 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
         for (i = 0; i < (uint)num_slots; i++) {
             for (k = 0; k < 2; k++) {
                 l = 0;
-                model.addConstr(bram[i][k] >= 0 - BIG_M * (1 - z[1][i][k][l++]),
+                model.addConstr(bram[i][k] >= 0 - M_cnt * (1 - z[1][i][k][l++]),
                                 "39");
 
                 model.addConstr(bram[i][k] >=
-                                    1 - BIG_M * (1 - z[1][i][k][l]) -
-                                        BIG_M * (1 - z[1][i][k][l + 1]),
+                                    1 - M_cnt * (1 - z[1][i][k][l]) -
+                                        M_cnt * (1 - z[1][i][k][l + 1]),
                                 "40");
                 l += 2;
 
                 model.addConstr(bram[i][k] >=
-                                    2 - BIG_M * (1 - z[1][i][k][l]) -
-                                        BIG_M * (1 - z[1][i][k][l + 1]),
+                                    2 - M_cnt * (1 - z[1][i][k][l]) -
+                                        M_cnt * (1 - z[1][i][k][l + 1]),
                                 "41");
                 l += 2;
 
                 model.addConstr(bram[i][k] >=
-                                    3 - BIG_M * (1 - z[1][i][k][l]) -
-                                        BIG_M * (1 - z[1][i][k][l + 1]),
+                                    3 - M_cnt * (1 - z[1][i][k][l]) -
+                                        M_cnt * (1 - z[1][i][k][l + 1]),
                                 "42");
                 l += 2;
 
                 model.addConstr(bram[i][k] >=
-                                    4 - BIG_M * (1 - z[1][i][k][l]) -
-                                        BIG_M * (1 - z[1][i][k][l + 1]),
+                                    4 - M_cnt * (1 - z[1][i][k][l]) -
+                                        M_cnt * (1 - z[1][i][k][l + 1]),
                                 "41");
                 l += 2;
 
                 model.addConstr(bram[i][k] >=
-                                    5 - BIG_M * (1 - z[1][i][k][l]) -
-                                        BIG_M * (1 - z[1][i][k][l + 1]),
+                                    5 - M_cnt * (1 - z[1][i][k][l]) -
+                                        M_cnt * (1 - z[1][i][k][l + 1]),
                                 "42");
                 l += 2;
 
                 model.addConstr(bram[i][k] >=
-                                    6 - BIG_M * (1 - z[1][i][k][l]) -
-                                        BIG_M * (1 - z[1][i][k][l + 1]),
+                                    6 - M_cnt * (1 - z[1][i][k][l]) -
+                                        M_cnt * (1 - z[1][i][k][l + 1]),
                                 "42");
                 l += 2;
             }
 
             for (k = 0; k < 2; k++) {
                 l = 0;
-                model.addConstr(0 >= bram[i][k] - BIG_M * (1 - z[1][i][k][l++]),
+                model.addConstr(0 >= bram[i][k] - M_cnt * (1 - z[1][i][k][l++]),
                                 "43");
 
                 model.addConstr(1 >= (bram[i][k]) -
-                                         BIG_M * (1 - z[1][i][k][l]) -
-                                         BIG_M * (1 - z[1][i][k][l + 1]),
+                                         M_cnt * (1 - z[1][i][k][l]) -
+                                         M_cnt * (1 - z[1][i][k][l + 1]),
                                 "44");
                 l += 2;
                 model.addConstr(2 >= (bram[i][k]) -
-                                         BIG_M * (1 - z[1][i][k][l]) -
-                                         BIG_M * (1 - z[1][i][k][l + 1]),
+                                         M_cnt * (1 - z[1][i][k][l]) -
+                                         M_cnt * (1 - z[1][i][k][l + 1]),
                                 "45");
                 l += 2;
 
                 model.addConstr(3 >= (bram[i][k]) -
-                                         BIG_M * (1 - z[1][i][k][l]) -
-                                         BIG_M * (1 - z[1][i][k][l + 1]),
+                                         M_cnt * (1 - z[1][i][k][l]) -
+                                         M_cnt * (1 - z[1][i][k][l + 1]),
                                 "46");
                 l += 2;
 
                 model.addConstr(4 >= (bram[i][k]) -
-                                         BIG_M * (1 - z[1][i][k][l]) -
-                                         BIG_M * (1 - z[1][i][k][l + 1]),
+                                         M_cnt * (1 - z[1][i][k][l]) -
+                                         M_cnt * (1 - z[1][i][k][l + 1]),
                                 "44");
                 l += 2;
 
                 model.addConstr(5 >= (bram[i][k]) -
-                                         BIG_M * (1 - z[1][i][k][l]) -
-                                         BIG_M * (1 - z[1][i][k][l + 1]),
+                                         M_cnt * (1 - z[1][i][k][l]) -
+                                         M_cnt * (1 - z[1][i][k][l + 1]),
                                 "45");
                 l += 2;
 
                 model.addConstr(6 >= (bram[i][k]) -
-                                         BIG_M * (1 - z[1][i][k][l]) -
-                                         BIG_M * (1 - z[1][i][k][l + 1]),
+                                         M_cnt * (1 - z[1][i][k][l]) -
+                                         M_cnt * (1 - z[1][i][k][l + 1]),
                                 "46");
             }
         }
@@ -1421,11 +1615,11 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (k = 0; k < 2; k++) {
                 l = 0;
                 GRBLinExpr exp;
-                model.addConstr(BIG_M * z[4][i][k][l++] >= 5 - x[i][k], "32");
-                model.addConstr(BIG_M * z[4][i][k][l++] >= x[i][k] - 4, "33");
-                model.addConstr(BIG_M * z[4][i][k][l++] >= 16 - x[i][k], "34");
-                model.addConstr(BIG_M * z[4][i][k][l++] >= x[i][k] - 15, "35");
-                model.addConstr(BIG_M * z[4][i][k][l++] >= W + 1 - x[i][k],
+                model.addConstr(M_col * z[4][i][k][l++] >= 5 - x[i][k], "32");
+                model.addConstr(M_col * z[4][i][k][l++] >= x[i][k] - 4, "33");
+                model.addConstr(M_col * z[4][i][k][l++] >= 16 - x[i][k], "34");
+                model.addConstr(M_col * z[4][i][k][l++] >= x[i][k] - 15, "35");
+                model.addConstr(M_col * z[4][i][k][l++] >= W + 1 - x[i][k],
                                 "36");
 
                 for (m = 0; m < l; m++)
@@ -1439,17 +1633,17 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (k = 0; k < 2; k++) {
                 l = 0;
                 model.addConstr(bram_fbdn[0][i][k] >=
-                                    0 - BIG_M * (1 - z[4][i][k][l++]),
+                                    0 - M_cnt * (1 - z[4][i][k][l++]),
                                 "39");
 
                 model.addConstr(bram_fbdn[0][i][k] >=
-                                    1 - BIG_M * (1 - z[4][i][k][l]) -
-                                        BIG_M * (1 - z[4][i][k][l + 1]),
+                                    1 - M_cnt * (1 - z[4][i][k][l]) -
+                                        M_cnt * (1 - z[4][i][k][l + 1]),
                                 "40");
                 l += 2;
                 model.addConstr(bram_fbdn[0][i][k] >=
-                                    2 - BIG_M * (1 - z[4][i][k][l]) -
-                                        BIG_M * (1 - z[4][i][k][l + 1]),
+                                    2 - M_cnt * (1 - z[4][i][k][l]) -
+                                        M_cnt * (1 - z[4][i][k][l + 1]),
                                 "41");
                 l += 2;
             }
@@ -1457,18 +1651,18 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (k = 0; k < 2; k++) {
                 l = 0;
                 model.addConstr(0 >= bram_fbdn[0][i][k] -
-                                         BIG_M * (1 - z[4][i][k][l++]),
+                                         M_cnt * (1 - z[4][i][k][l++]),
                                 "43");
 
                 model.addConstr(1 >= (bram_fbdn[0][i][k]) -
-                                         BIG_M * (1 - z[4][i][k][l]) -
-                                         BIG_M * (1 - z[4][i][k][l + 1]),
+                                         M_cnt * (1 - z[4][i][k][l]) -
+                                         M_cnt * (1 - z[4][i][k][l + 1]),
                                 "44");
                 l += 2;
 
                 model.addConstr(2 >= (bram_fbdn[0][i][k]) -
-                                         BIG_M * (1 - z[4][i][k][l]) -
-                                         BIG_M * (1 - z[4][i][k][l + 1]),
+                                         M_cnt * (1 - z[4][i][k][l]) -
+                                         M_cnt * (1 - z[4][i][k][l + 1]),
                                 "45");
                 l += 2;
             }
@@ -1487,17 +1681,17 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (k = 0; k < 2; k++) {
                 l = 0;
                 GRBLinExpr exp;
-                model.addConstr(BIG_M * z[2][i][k][l++] >= 8 - x[i][k], "47");
-                model.addConstr(BIG_M * z[2][i][k][l++] >= x[i][k] - 7, "48");
-                model.addConstr(BIG_M * z[2][i][k][l++] >= 13 - x[i][k], "49");
-                model.addConstr(BIG_M * z[2][i][k][l++] >= x[i][k] - 12, "50");
-                model.addConstr(BIG_M * z[2][i][k][l++] >= 23 - x[i][k], "49");
-                model.addConstr(BIG_M * z[2][i][k][l++] >= x[i][k] - 22, "50");
-                model.addConstr(BIG_M * z[2][i][k][l++] >= 58 - x[i][k], "49");
-                model.addConstr(BIG_M * z[2][i][k][l++] >= x[i][k] - 57, "50");
-                model.addConstr(BIG_M * z[2][i][k][l++] >= 63 - x[i][k], "49");
-                model.addConstr(BIG_M * z[2][i][k][l++] >= x[i][k] - 62, "50");
-                model.addConstr(BIG_M * z[2][i][k][l++] >= W + 1 - x[i][k],
+                model.addConstr(M_col * z[2][i][k][l++] >= 8 - x[i][k], "47");
+                model.addConstr(M_col * z[2][i][k][l++] >= x[i][k] - 7, "48");
+                model.addConstr(M_col * z[2][i][k][l++] >= 13 - x[i][k], "49");
+                model.addConstr(M_col * z[2][i][k][l++] >= x[i][k] - 12, "50");
+                model.addConstr(M_col * z[2][i][k][l++] >= 23 - x[i][k], "49");
+                model.addConstr(M_col * z[2][i][k][l++] >= x[i][k] - 22, "50");
+                model.addConstr(M_col * z[2][i][k][l++] >= 58 - x[i][k], "49");
+                model.addConstr(M_col * z[2][i][k][l++] >= x[i][k] - 57, "50");
+                model.addConstr(M_col * z[2][i][k][l++] >= 63 - x[i][k], "49");
+                model.addConstr(M_col * z[2][i][k][l++] >= x[i][k] - 62, "50");
+                model.addConstr(M_col * z[2][i][k][l++] >= W + 1 - x[i][k],
                                 "51");
 
                 for (m = 0; m < l; m++)
@@ -1511,58 +1705,58 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (k = 0; k < 2; k++) {
                 l = 0;
                 model.addConstr(
-                    dsp[i][k] >= (0 - BIG_M * (1 - z[2][i][k][l++])), "52");
+                    dsp[i][k] >= (0 - M_cnt * (1 - z[2][i][k][l++])), "52");
 
-                model.addConstr(dsp[i][k] >= (1 - BIG_M * (1 - z[2][i][k][l]) -
-                                              BIG_M * (1 - z[2][i][k][l + 1])),
+                model.addConstr(dsp[i][k] >= (1 - M_cnt * (1 - z[2][i][k][l]) -
+                                              M_cnt * (1 - z[2][i][k][l + 1])),
                                 "53");
                 l += 2;
-                model.addConstr(dsp[i][k] >= (2 - BIG_M * (1 - z[2][i][k][l]) -
-                                              BIG_M * (1 - z[2][i][k][l + 1])),
+                model.addConstr(dsp[i][k] >= (2 - M_cnt * (1 - z[2][i][k][l]) -
+                                              M_cnt * (1 - z[2][i][k][l + 1])),
                                 "54");
                 l += 2;
 
-                model.addConstr(dsp[i][k] >= (3 - BIG_M * (1 - z[2][i][k][l]) -
-                                              BIG_M * (1 - z[2][i][k][l + 1])),
+                model.addConstr(dsp[i][k] >= (3 - M_cnt * (1 - z[2][i][k][l]) -
+                                              M_cnt * (1 - z[2][i][k][l + 1])),
                                 "53");
                 l += 2;
 
-                model.addConstr(dsp[i][k] >= (4 - BIG_M * (1 - z[2][i][k][l]) -
-                                              BIG_M * (1 - z[2][i][k][l + 1])),
+                model.addConstr(dsp[i][k] >= (4 - M_cnt * (1 - z[2][i][k][l]) -
+                                              M_cnt * (1 - z[2][i][k][l + 1])),
                                 "54");
                 l += 2;
 
-                model.addConstr(dsp[i][k] >= (5 - BIG_M * (1 - z[2][i][k][l]) -
-                                              BIG_M * (1 - z[2][i][k][l + 1])),
+                model.addConstr(dsp[i][k] >= (5 - M_cnt * (1 - z[2][i][k][l]) -
+                                              M_cnt * (1 - z[2][i][k][l + 1])),
                                 "53");
                 l += 2;
             }
 
             for (k = 0; k < 2; k++) {
                 l = 0;
-                model.addConstr(0 >= dsp[i][k] - BIG_M * (1 - z[2][i][k][l++]),
+                model.addConstr(0 >= dsp[i][k] - M_cnt * (1 - z[2][i][k][l++]),
                                 "55");
 
-                model.addConstr(1 >= (dsp[i][k]) - BIG_M * (1 - z[2][i][k][l]) -
-                                         BIG_M * (1 - z[2][i][k][l + 1]),
+                model.addConstr(1 >= (dsp[i][k]) - M_cnt * (1 - z[2][i][k][l]) -
+                                         M_cnt * (1 - z[2][i][k][l + 1]),
                                 "56");
                 l += 2;
 
-                model.addConstr(2 >= (dsp[i][k]) - BIG_M * (1 - z[2][i][k][l]) -
-                                         BIG_M * (1 - z[2][i][k][l + 1]),
+                model.addConstr(2 >= (dsp[i][k]) - M_cnt * (1 - z[2][i][k][l]) -
+                                         M_cnt * (1 - z[2][i][k][l + 1]),
                                 "57");
                 l += 2;
-                model.addConstr(3 >= (dsp[i][k]) - BIG_M * (1 - z[2][i][k][l]) -
-                                         BIG_M * (1 - z[2][i][k][l + 1]),
+                model.addConstr(3 >= (dsp[i][k]) - M_cnt * (1 - z[2][i][k][l]) -
+                                         M_cnt * (1 - z[2][i][k][l + 1]),
                                 "56");
                 l += 2;
 
-                model.addConstr(4 >= (dsp[i][k]) - BIG_M * (1 - z[2][i][k][l]) -
-                                         BIG_M * (1 - z[2][i][k][l + 1]),
+                model.addConstr(4 >= (dsp[i][k]) - M_cnt * (1 - z[2][i][k][l]) -
+                                         M_cnt * (1 - z[2][i][k][l + 1]),
                                 "57");
                 l += 2;
-                model.addConstr(5 >= (dsp[i][k]) - BIG_M * (1 - z[2][i][k][l]) -
-                                         BIG_M * (1 - z[2][i][k][l + 1]),
+                model.addConstr(5 >= (dsp[i][k]) - M_cnt * (1 - z[2][i][k][l]) -
+                                         M_cnt * (1 - z[2][i][k][l + 1]),
                                 "56");
             }
         }
@@ -1577,11 +1771,11 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (k = 0; k < 2; k++) {
                 l = 0;
                 GRBLinExpr exp;
-                model.addConstr(BIG_M * z[5][i][k][l++] >= 8 - x[i][k], "47");
-                model.addConstr(BIG_M * z[5][i][k][l++] >= x[i][k] - 7, "48");
-                model.addConstr(BIG_M * z[5][i][k][l++] >= 13 - x[i][k], "49");
-                model.addConstr(BIG_M * z[5][i][k][l++] >= x[i][k] - 12, "50");
-                model.addConstr(BIG_M * z[5][i][k][l++] >= W + 1 - x[i][k],
+                model.addConstr(M_col * z[5][i][k][l++] >= 8 - x[i][k], "47");
+                model.addConstr(M_col * z[5][i][k][l++] >= x[i][k] - 7, "48");
+                model.addConstr(M_col * z[5][i][k][l++] >= 13 - x[i][k], "49");
+                model.addConstr(M_col * z[5][i][k][l++] >= x[i][k] - 12, "50");
+                model.addConstr(M_col * z[5][i][k][l++] >= W + 1 - x[i][k],
                                 "49");
 
                 for (m = 0; m < l; m++)
@@ -1595,18 +1789,18 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (k = 0; k < 2; k++) {
                 l = 0;
                 model.addConstr(dsp_fbdn[0][i][k] >=
-                                    (0 - BIG_M * (1 - z[5][i][k][l++])),
+                                    (0 - M_cnt * (1 - z[5][i][k][l++])),
                                 "52");
 
                 model.addConstr(dsp_fbdn[0][i][k] >=
-                                    (1 - BIG_M * (1 - z[5][i][k][l]) -
-                                     BIG_M * (1 - z[5][i][k][l + 1])),
+                                    (1 - M_cnt * (1 - z[5][i][k][l]) -
+                                     M_cnt * (1 - z[5][i][k][l + 1])),
                                 "53");
                 l += 2;
 
                 model.addConstr(dsp_fbdn[0][i][k] >=
-                                    (2 - BIG_M * (1 - z[5][i][k][l]) -
-                                     BIG_M * (1 - z[5][i][k][l + 1])),
+                                    (2 - M_cnt * (1 - z[5][i][k][l]) -
+                                     M_cnt * (1 - z[5][i][k][l + 1])),
                                 "54");
                 l += 2;
             }
@@ -1614,18 +1808,18 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (k = 0; k < 2; k++) {
                 l = 0;
                 model.addConstr(0 >= dsp_fbdn[0][i][k] -
-                                         BIG_M * (1 - z[5][i][k][l++]),
+                                         M_cnt * (1 - z[5][i][k][l++]),
                                 "55");
 
                 model.addConstr(1 >= (dsp_fbdn[0][i][k]) -
-                                         BIG_M * (1 - z[5][i][k][l]) -
-                                         BIG_M * (1 - z[5][i][k][l + 1]),
+                                         M_cnt * (1 - z[5][i][k][l]) -
+                                         M_cnt * (1 - z[5][i][k][l + 1]),
                                 "56");
                 l += 2;
 
                 model.addConstr(2 >= (dsp_fbdn[0][i][k]) -
-                                         BIG_M * (1 - z[5][i][k][l]) -
-                                         BIG_M * (1 - z[5][i][k][l + 1]),
+                                         M_cnt * (1 - z[5][i][k][l]) -
+                                         M_cnt * (1 - z[5][i][k][l + 1]),
                                 "57");
             }
         }
@@ -1639,16 +1833,19 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             GRBLinExpr exp_clb_fbdn, exp_bram_fbdn, exp_dsp_fbdn;
             for (j = 0; j < (uint)num_clk_regs; j++) {
                 // CLB constraints
-                model.addConstr(tau[0][i][j] <= 10000 * beta[i][j], "58");
+                model.addConstr(tau[0][i][j] <= tau_m(10000) * beta[i][j],
+                                "58");
                 model.addConstr(tau[0][i][j] <= clb[i][1] - clb[i][0], "59");
-                model.addConstr(tau[0][i][j] >= (clb[i][1] - clb[i][0]) -
-                                                    (1 - beta[i][j]) * clb_max,
+                model.addConstr(tau[0][i][j] >=
+                                    (clb[i][1] - clb[i][0]) -
+                                        (1 - beta[i][j]) * tau_m(clb_max),
                                 "60");
                 model.addConstr(tau[0][i][j] >= 0, "15");
 
                 // CLB_FBDN 0
                 model.addConstr(tau_fbdn[0][0][i][j] <=
-                                    10000 * (beta_fbdn[j] + beta[i][j] - 1),
+                                    tau_m(10000) *
+                                        (beta_fbdn[j] + beta[i][j] - 1),
                                 "58");
                 model.addConstr(tau_fbdn[0][0][i][j] <=
                                     clb_fbdn[0][i][1] - clb_fbdn[0][i][0],
@@ -1656,13 +1853,14 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                 model.addConstr(tau_fbdn[0][0][i][j] >=
                                     (clb_fbdn[0][i][1] - clb_fbdn[0][i][0]) -
                                         (2 - beta[i][j] - beta_fbdn[j]) *
-                                            clb_max,
+                                            tau_m(clb_max),
                                 "60");
                 model.addConstr(tau_fbdn[0][0][i][j] >= 0, "15");
 
                 // CLB_FBDN 1
                 model.addConstr(tau_fbdn[1][0][i][j] <=
-                                    10000 * (beta_fbdn[j] + beta[i][j] - 1),
+                                    tau_m(10000) *
+                                        (beta_fbdn[j] + beta[i][j] - 1),
                                 "58");
                 model.addConstr(tau_fbdn[1][0][i][j] <=
                                     clb_fbdn[1][i][1] - clb_fbdn[1][i][0],
@@ -1670,21 +1868,23 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                 model.addConstr(tau_fbdn[1][0][i][j] >=
                                     (clb_fbdn[1][i][1] - clb_fbdn[1][i][0]) -
                                         (2 - beta[i][j] - beta_fbdn[j]) *
-                                            clb_max,
+                                            tau_m(clb_max),
                                 "60");
                 model.addConstr(tau_fbdn[1][0][i][j] >= 0, "15");
 
                 // BRAM constraints
-                model.addConstr(tau[1][i][j] <= 1000 * beta[i][j], "61");
+                model.addConstr(tau[1][i][j] <= tau_m(1000) * beta[i][j], "61");
                 model.addConstr(tau[1][i][j] <= bram[i][1] - bram[i][0], "62");
-                model.addConstr(tau[1][i][j] >= (bram[i][1] - bram[i][0]) -
-                                                    (1 - beta[i][j]) * bram_max,
+                model.addConstr(tau[1][i][j] >=
+                                    (bram[i][1] - bram[i][0]) -
+                                        (1 - beta[i][j]) * tau_m(bram_max),
                                 "63");
                 model.addConstr(tau[1][i][j] >= 0, "53");
 
                 // BRAM_fbdn constraints
                 model.addConstr(tau_fbdn[0][1][i][j] <=
-                                    10000 * (beta_fbdn[j] + beta[i][j] - 1),
+                                    tau_m(10000) *
+                                        (beta_fbdn[j] + beta[i][j] - 1),
                                 "61");
                 model.addConstr(tau_fbdn[0][1][i][j] <=
                                     bram_fbdn[0][i][1] - bram_fbdn[0][i][0],
@@ -1692,21 +1892,23 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                 model.addConstr(tau_fbdn[0][1][i][j] >=
                                     (bram_fbdn[0][i][1] - bram_fbdn[0][i][0]) -
                                         (2 - beta[i][j] - beta_fbdn[j]) *
-                                            bram_max,
+                                            tau_m(bram_max),
                                 "63");
                 model.addConstr(tau_fbdn[0][1][i][j] >= 0, "53");
 
                 // DSP constraints
-                model.addConstr(tau[2][i][j] <= 1000 * beta[i][j], "64");
+                model.addConstr(tau[2][i][j] <= tau_m(1000) * beta[i][j], "64");
                 model.addConstr(tau[2][i][j] <= dsp[i][1] - dsp[i][0], "65");
-                model.addConstr(tau[2][i][j] >= (dsp[i][1] - dsp[i][0]) -
-                                                    (1 - beta[i][j]) * dsp_max,
+                model.addConstr(tau[2][i][j] >=
+                                    (dsp[i][1] - dsp[i][0]) -
+                                        (1 - beta[i][j]) * tau_m(dsp_max),
                                 "66");
                 model.addConstr(tau[2][i][j] >= 0, "67");
 
                 // DSP_fbdn constraints
                 model.addConstr(tau_fbdn[0][2][i][j] <=
-                                    10000 * (beta_fbdn[j] + beta[i][j] - 1),
+                                    tau_m(10000) *
+                                        (beta_fbdn[j] + beta[i][j] - 1),
                                 "64");
                 model.addConstr(tau_fbdn[0][2][i][j] <=
                                     dsp_fbdn[0][i][1] - dsp_fbdn[0][i][0],
@@ -1714,7 +1916,7 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                 model.addConstr(tau_fbdn[0][2][i][j] >=
                                     (dsp_fbdn[0][i][1] - dsp_fbdn[0][i][0]) -
                                         (2 - beta[i][j] - beta_fbdn[j]) *
-                                            dsp_max,
+                                            tau_m(dsp_max),
                                 "66");
                 model.addConstr(tau_fbdn[0][2][i][j] >= 0, "67");
 
@@ -1729,14 +1931,14 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             }
 
             // partitioning patch
-            for (int a = 0; a < (int)task_set->maxHW_Tasks; a++)
+            for (int a = 0; a < (int)t.maxHW_Tasks; a++)
                 exp_hw_task += A[a][i];
 
             // partitioning patch
             model.addConstr(clb_per_tile * (exp_clb - exp_clb_fbdn) >= b[0][i],
                             "68");
             model.addConstr(clb_per_tile * (exp_clb - exp_clb_fbdn) <=
-                                BIG_M * exp_hw_task,
+                                M_res(clb_per_tile) * exp_hw_task,
                             "con hw1");
             model.addConstr(wasted[i][0] ==
                                 clb_per_tile * (exp_clb - exp_clb_fbdn) -
@@ -1752,7 +1954,7 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             model.addConstr(
                 bram_per_tile * (exp_bram - exp_bram_fbdn) >= b[1][i], "69");
             model.addConstr(bram_per_tile * (exp_bram - exp_bram_fbdn) <=
-                                BIG_M * exp_hw_task,
+                                M_res(bram_per_tile) * exp_hw_task,
                             "con hw1");
             model.addConstr(wasted[i][1] ==
                                 bram_per_tile * (exp_bram - exp_bram_fbdn) -
@@ -1769,7 +1971,7 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             model.addConstr(dsp_per_tile * (exp_dsp - exp_dsp_fbdn) >= b[2][i],
                             "70");
             model.addConstr(dsp_per_tile * (exp_dsp - exp_dsp_fbdn) <=
-                                BIG_M * exp_hw_task,
+                                M_res(dsp_per_tile) * exp_hw_task,
                             "con hw1");
             model.addConstr(wasted[i][2] ==
                                 dsp_per_tile * (exp_dsp - exp_dsp_fbdn) -
@@ -1806,19 +2008,19 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                    - x[k][0] + 1, "65"); model.addConstr(BIG_M * Alpha[i][k] >=
                    x[k][1] - x[i][0] + 1, "66"); model.addConstr(BIG_M *
                    Omega[i][k] >= y[i] + h[i] - y[k], "67");
-                                model.addConstr(BIG_M * Psi[i][k]   >= y[k] +
+                                model.addConstr(M_y * Psi[i][k]   >= y[k] +
                    h[k] - y[i], "68");
                   */
-                model.addConstr(BIG_M * gamma[i][k] >= x[k][0] + 1 - x[i][0],
+                model.addConstr(M_x * gamma[i][k] >= x[k][0] + 1 - x[i][0],
                                 "63");
-                model.addConstr(BIG_M * theta[i][k] >= (y[k] - y[i]), "64");
-                model.addConstr(BIG_M * Gamma[i][k] >= x[i][1] - x[k][0] + 1,
+                model.addConstr(M_y * theta[i][k] >= (y[k] - y[i]), "64");
+                model.addConstr(M_x * Gamma[i][k] >= x[i][1] - x[k][0] + 1,
                                 "65");
-                model.addConstr(BIG_M * Alpha[i][k] >= x[k][1] - x[i][0] + 1,
+                model.addConstr(M_x * Alpha[i][k] >= x[k][1] - x[i][0] + 1,
                                 "66");
-                model.addConstr(BIG_M * Omega[i][k] >= y[i] + h[i] - y[k],
+                model.addConstr(M_y * Omega[i][k] >= y[i] + h[i] - y[k],
                                 "67");
-                model.addConstr(BIG_M * Psi[i][k] >= y[k] + h[k] - y[i], "68");
+                model.addConstr(M_y * Psi[i][k] >= y[k] + h[k] - y[i], "68");
             }
         }
 
@@ -1925,17 +2127,17 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             for (j = 0; j < (uint)num_fbdn_edge; j++) {
                 l = 0;
                 model.addConstr(x[i][0] - forbidden_boundaries_left[j] <=
-                                    -0.01 + kappa[i][j][l] * BIG_M,
+                                    -0.01 + kappa[i][j][l] * M_edge,
                                 "edge_con");
                 model.addConstr(x[i][0] - forbidden_boundaries_left[j] >=
-                                    0.01 - (1 - kappa[i][j][l]) * BIG_M,
+                                    0.01 - (1 - kappa[i][j][l]) * M_edge,
                                 "edge_con_1");
                 l++;
                 model.addConstr(x[i][1] - forbidden_boundaries_right[j] <=
-                                    -0.01 + kappa[i][j][l] * BIG_M,
+                                    -0.01 + kappa[i][j][l] * M_edge,
                                 "edge_con_2");
                 model.addConstr(x[i][1] - forbidden_boundaries_right[j] >=
-                                    0.01 - (1 - kappa[i][j][l]) * BIG_M,
+                                    0.01 - (1 - kappa[i][j][l]) * M_edge,
                                 "edge_con_3");
             }
         }
@@ -2003,25 +2205,148 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             cout << "W H and wl max is " << W << " " << H * 20 << " " << wl_max
                  << endl;
         }
-        // model.setObjective((obj_x + obj_y ) / wl_max, GRB_MINIMIZE);
-        model.setObjective(obj_wasted_clb, GRB_MINIMIZE);
-        // model.setObjective(obj_wasted_bram, GRB_MINIMIZE);
-        //  model.setObjective(obj_wasted_dsp,  GRB_MINIMIZE);
+        s.obj_wasted_clb = obj_wasted_clb;
+        s.obj_wasted_bram = obj_wasted_bram;
+        s.obj_wasted_dsp = obj_wasted_dsp;
+        s.obj_wirelength = GRBLinExpr();
+        s.wl_max = wl_max;
+        if (wl_max > 0) {
+            s.obj_wirelength = (obj_x + obj_y) * (1.0 / wl_max);
+            s.con_wirelength.push_back(
+                model.addConstr(s.obj_wirelength <= 1.0, "wl_eps"));
+        }
+    } catch (...) {
+        s.clear();
+        throw;
+    }
+}
+
+// 按 build_model 中约束的添加顺序修改系数与右端项
+void milp_solver_pynq::update_model(milp_session_pynq &s, Taskset &t,
+                                    Platform &platform,
+                                    vector<double> &slacks) {
+    GRBModel &model = *s.model;
+    const auto &A = s.A;
+
+    for (uint x = 0; x < platform.N_FPGA_RESOURCES; x++)
+        s.con_total[x].set(GRB_DoubleAttr_RHS,
+                           (double)platform.maxFPGAResources[x]);
+
+    size_t n = 0;
+    for (uint x = 0; x < platform.N_FPGA_RESOURCES; x++)
+        for (uint k = 0; k < t.maxPartitions; k++)
+            for (uint a = 0; a < t.maxHW_Tasks; a++)
+                model.chgCoeff(s.con_demand[n++], A[a][k],
+                               -(double)t.HW_Tasks[a].resDemand[x]);
+
+    n = 0;
+    for (uint k = 0; k < t.maxPartitions; k++)
+        for (uint a = 0; a < t.maxHW_Tasks; a++)
+            for (uint b = 0; b < t.maxHW_Tasks; b++) {
+                if (a == b)
+                    continue;
+                const double WCET = (double)t.HW_Tasks[b].WCET;
+                model.chgCoeff(s.con_slot[n], A[a][k], -WCET);
+                model.chgCoeff(s.con_slot[n], A[b][k], -WCET);
+                s.con_slot[n++].set(GRB_DoubleAttr_RHS, -WCET);
+            }
+
+    const double BIG_M_con7 = big_m_con7(t, platform);
+    for (n = 0; n < s.con_delta.size(); n++) {
+        model.chgCoeff(s.con_delta[n], s.gamma_part[s.con_delta_task[n]],
+                       -BIG_M_con7);
+        s.con_delta[n].set(GRB_DoubleAttr_RHS, -BIG_M_con7);
+    }
+
+    for (uint i = 0; i < t.maxSW_Tasks; i++) {
+        double rhs = slacks[i];
+        for (auto a : t.SW_Tasks[i].H)
+            rhs -= t.HW_Tasks[a].WCET;
+        s.con_slack[i].set(GRB_DoubleAttr_RHS, rhs);
+    }
+    model.update();
+}
+
+int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
+                                 vector<double> &slacks, bool preemptive_FRI,
+                                 pfsRef to_sim) {
+    int status;
+    unsigned long i, m;
+    unsigned long num_active_partitions = 0;
+    const int num_slots = m_ctx.num_slots;
+    const int clb_per_tile = m_ctx.clb_per_tile;
+    const int bram_per_tile = m_ctx.bram_per_tile;
+    const int dsp_per_tile = m_ctx.dsp_per_tile;
+    // 出错时不留下上一次求解的状态
+    m_ctx.status = 0;
+
+    try {
+        auto &s = session();
+        GRBConstr *c = NULL;
+
+        // 结构不变时只修改数据，否则重新构建模型
+        const auto start = std::chrono::steady_clock::now();
+        auto shape = pynq_model_shape(m_ctx, t, platform, preemptive_FRI);
+        if (!s.model || s.shape != shape) {
+            build_model(s, t, platform, slacks, preemptive_FRI);
+            s.shape = std::move(shape);
+            s.builds++;
+        } else {
+            update_model(s, t, platform, slacks);
+            s.warm_start();
+        }
+        s.solves++;
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        s.model_seconds += elapsed.count();
+
+        GRBModel &model = *s.model;
+        set_objective(model, s, m_ctx.weights);
+        for (auto &con : s.con_wirelength)
+            con.set(GRB_DoubleAttr_RHS, m_ctx.wirelength_bound);
+        const auto &A = s.A;
+        const auto &b = s.b;
+        const auto &gamma_part = s.gamma_part;
+        const auto &r = s.r;
+        const auto &x = s.x;
+        const auto &y = s.y;
+        const auto &w = s.w;
+        const auto &h = s.h;
+        const auto &clb = s.clb;
+        const auto &bram = s.bram;
+        const auto &dsp = s.dsp;
+        const auto &clb_fbdn_tot = s.clb_fbdn_tot;
+        const auto &bram_fbdn_tot = s.bram_fbdn_tot;
+        const auto &dsp_fbdn_tot = s.dsp_fbdn_tot;
 
         // Optimize
         /****************************************************************************
         Optimize
         *****************************************************************************/
-        model.set(GRB_IntParam_Threads, 8);
-        model.set(GRB_DoubleParam_TimeLimit, 1800);
+        model.set(GRB_IntParam_Threads, m_ctx.threads);
+        model.set(GRB_DoubleParam_TimeLimit, m_ctx.time_limit);
         model.set(GRB_DoubleParam_IntFeasTol, 1e-9);
         model.optimize();
-        wasted_clb_pynq = 0;
-        wasted_bram_pynq = 0;
-        wasted_dsp_pynq = 0;
+        s.solve_seconds += model.get(GRB_DoubleAttr_Runtime);
+        m_ctx.objective = 0;
+        m_ctx.objectives.clear();
+        m_ctx.wasted_clb_pynq = 0;
+        m_ctx.wasted_bram_pynq = 0;
+        m_ctx.wasted_dsp_pynq = 0;
+        m_ctx.wirelength = 0;
+        m_ctx.wl_max = s.wl_max;
+        if (model.get(GRB_IntAttr_SolCount) > 0) {
+            s.save_incumbent();
+            read_objectives(model, m_ctx);
+            m_ctx.wasted_clb_pynq = std::lround(s.obj_wasted_clb.getValue());
+            m_ctx.wasted_bram_pynq = std::lround(s.obj_wasted_bram.getValue());
+            m_ctx.wasted_dsp_pynq = std::lround(s.obj_wasted_dsp.getValue());
+            m_ctx.wirelength = s.obj_wirelength.getValue();
+        }
         // unsigned long w_x = 0, w_y = 0;
 
         status = model.get(GRB_IntAttr_Status);
+        m_ctx.status = status;
         if (status == GRB_OPTIMAL) {
             // ------------------------------------------------------------
             // Partition OUTPUT
@@ -2111,6 +2436,10 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             // unsigned int index = 0, num_tasks_in_part, task_id_in_part;
             unsigned int index = 0, num_tasks_in_part;
 
+            // 会话中的求解器会被多次调用，先清除上一次的分配
+            for (auto &alloc : *to_sim->task_alloc)
+                alloc.task_id.clear();
+
             for (uint k = 0; k < t.maxPartitions; k++) {
                 is_part_allocated = false;
                 num_tasks_in_part = 0;
@@ -2153,10 +2482,10 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
             cout << endl;
 
             for (i = 0; i < (uint)num_slots; i++) {
-                cout << "RM_" << i << "\t" << "CLB = " << clb_req_pynq[i]
+                cout << "RM_" << i << "\t" << "CLB = " << m_ctx.clb_req_pynq[i]
                      << endl;
-                cout << "\t" << "BRAM = " << bram_req_pynq[i] << endl;
-                cout << "\t" << "DSP  = " << dsp_req_pynq[i] << endl;
+                cout << "\t" << "BRAM = " << m_ctx.bram_req_pynq[i] << endl;
+                cout << "\t" << "DSP  = " << m_ctx.dsp_req_pynq[i] << endl;
 
                 cout << endl;
             }
@@ -2218,7 +2547,7 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                                  h[i].get(GRB_DoubleAttr_X) -
                              clb_fbdn_tot[i].get(GRB_DoubleAttr_X)) *
                                 clb_per_tile
-                         << "\t" << task_set->HW_Tasks[i].resDemand[CLB]
+                         << "\t" << t.HW_Tasks[i].resDemand[CLB]
 
                          << "\t" << bram[i][0].get(GRB_DoubleAttr_X) << "\t"
                          << bram[i][1].get(GRB_DoubleAttr_X) << "\t"
@@ -2227,7 +2556,7 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                                  h[i].get(GRB_DoubleAttr_X) -
                              bram_fbdn_tot[i].get(GRB_DoubleAttr_X)) *
                                 bram_per_tile
-                         << "\t" << task_set->HW_Tasks[i].resDemand[BRAM]
+                         << "\t" << t.HW_Tasks[i].resDemand[BRAM]
 
                          << "\t" << dsp[i][0].get(GRB_DoubleAttr_X) << "\t"
                          << dsp[i][1].get(GRB_DoubleAttr_X) << "\t"
@@ -2236,7 +2565,7 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                                  h[i].get(GRB_DoubleAttr_X) -
                              dsp_fbdn_tot[i].get(GRB_DoubleAttr_X)) *
                                 dsp_per_tile
-                         << "\t" << task_set->HW_Tasks[i].resDemand[DSP]
+                         << "\t" << t.HW_Tasks[i].resDemand[DSP]
                          << endl;
                 }
 
@@ -2327,9 +2656,9 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
 
         }
 
-        else {
+        else if (status == GRB_INFEASIBLE) {
 
-            model.set(GRB_IntParam_Threads, 8);
+            model.set(GRB_IntParam_Threads, m_ctx.threads);
             model.set(GRB_DoubleParam_TimeLimit, 120);
             model.computeIIS();
 
@@ -2341,13 +2670,16 @@ int milp_solver_pynq::solve_milp(Taskset &t, Platform &platform,
                 if (c[i].get(GRB_IntAttr_IISConstr) == 1)
                     cout << c[i].get(GRB_StringAttr_ConstrName) << endl;
         }
-    } catch (GRBException e) {
-        cout << "Error code =" << e.getErrorCode() << endl;
-        cout << e.getMessage() << endl;
-        exit(EXIT_FAILURE);
+    } catch (GRBException &e) {
+        // 模型可能只构建了一半，下次求解时重新构建；错误交给调用方处理，
+        // DSE 中一个点出错不应结束整个进程
+        session().clear();
+        throw std::runtime_error("Gurobi error " +
+                                 std::to_string(e.getErrorCode()) + ": " +
+                                 e.getMessage());
     } catch (...) {
-        cout << "exception while solving milp" << endl;
-        exit(EXIT_FAILURE);
+        session().clear();
+        throw;
     }
     return status;
 }
@@ -2359,41 +2691,41 @@ int milp_solver_pynq::start_optimizer(pfsRef to_sim, ptsRef param) {
     int temp;
     unsigned long i;
 
-    num_slots = param->num_rm_modules;
-    num_forbidden_slots = param->num_forbidden_slots;
-    num_rows = param->num_rows;
-    H = param->num_clk_regs;
-    W = param->width;
-
-    num_clk_regs = param->num_clk_regs;
-    num_conn_slots_pynq = (param->num_connected_slots);
-    clb_per_tile = param->clb_per_tile;
-    bram_per_tile = param->bram_per_tile;
-    dsp_per_tile = param->dsp_per_tile;
-
-    task_set = param->task_set;
-    platform = param->platform;
-    slacks = *param->slacks;
-
-    for (i = 0; i < (uint)num_slots; i++) {
-        clb_req_pynq[i] = (*param->clb)[i];
-        bram_req_pynq[i] = (*param->bram)[i];
-        dsp_req_pynq[i] = (*param->dsp)[i];
+    m_ctx.num_slots = param->num_rm_modules;
+    m_ctx.num_forbidden_slots = param->num_forbidden_slots;
+    m_ctx.num_rows = param->num_rows;
+    m_ctx.H = param->num_clk_regs;
+    m_ctx.W = param->width;
+
+    m_ctx.num_clk_regs = param->num_clk_regs;
+    m_ctx.num_conn_slots_pynq = (param->num_connected_slots);
+    m_ctx.clb_per_tile = param->clb_per_tile;
+    m_ctx.bram_per_tile = param->bram_per_tile;
+    m_ctx.dsp_per_tile = param->dsp_per_tile;
+
+    m_ctx.task_set = param->task_set;
+    m_ctx.platform = param->platform;
+    m_ctx.slacks = *param->slacks;
+
+    for (i = 0; i < (uint)m_ctx.num_slots; i++) {
+        m_ctx.clb_req_pynq[i] = (*param->clb)[i];
+        m_ctx.bram_req_pynq[i] = (*param->bram)[i];
+        m_ctx.dsp_req_pynq[i] = (*param->dsp)[i];
         // cout << "clb " << clb_req_pynq[i] << " bram " <<
         // bram_req_pynq[i] << "dsp " << dsp_req_pynq[i] << endl;
     }
 
-    for (i = 0; i < (uint)num_conn_slots_pynq; i++) {
+    for (i = 0; i < (uint)m_ctx.num_conn_slots_pynq; i++) {
         for (k = 0; k < 3; k++)
-            conn_matrix_pynq[i][k] = (*(param->conn_vector))[i][k];
+            m_ctx.conn_matrix_pynq[i][k] = (*(param->conn_vector))[i][k];
     }
 
     m = 0;
-    for (i = 0; i < (uint)num_conn_slots_pynq; i++) {
+    for (i = 0; i < (uint)m_ctx.num_conn_slots_pynq; i++) {
         m = 0;
         //       for(k = 0; k < 3; k++)
-        temp = conn_matrix_pynq[i][m] + conn_matrix_pynq[i][m + 1] +
-               conn_matrix_pynq[i][m + 2];
+        const auto &conn = m_ctx.conn_matrix_pynq[i];
+        temp = conn[m] + conn[m + 1] + conn[m + 2];
         cout << "inside solver " << temp << /*m <<
         conn_matrix_pynq[i][m++] << " m " << m <<
         conn_matrix_pynq[i][m++] << " m" << m << <<
@@ -2406,8 +2738,8 @@ int milp_solver_pynq::start_optimizer(pfsRef to_sim, ptsRef param) {
         // cout << conn_matrix_pynq[i][k] << endl;
     }
 
-    for (i = 0; i < (uint)num_forbidden_slots; i++) {
-        fs_pynq[i] = (*param->fbdn_slot)[i];
+    for (i = 0; i < (uint)m_ctx.num_forbidden_slots; i++) {
+        m_ctx.fs_pynq[i] = (*param->fbdn_slot)[i];
         //        cout <<"PYNQ_OPT: forbidden " << (uint)num_forbidden_slots <<
         //        " " <<
         //               fs_pynq[i].x << " " << fs_pynq[i].y << " " <<
@@ -2415,7 +2747,8 @@ int milp_solver_pynq::start_optimizer(pfsRef to_sim, ptsRef param) {
     }
 
     cout << "PYNQ_OPT: starting PYNQ optimizer" << endl;
-    status = solve_milp(*task_set, *platform, slacks, false, to_sim);
+    solve_milp(*m_ctx.task_set, *m_ctx.platform, m_ctx.slacks,
+               m_ctx.preemptive_FRI, to_sim);
     return 0;
 }
 
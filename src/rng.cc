@@ -0,0 +1,104 @@
+#include "rng.h"
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+namespace seu {
+
+auto splitmix64(std::uint64_t x) -> std::uint64_t {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+Rng::Rng(std::uint64_t seed) {
+    for (auto &s : m_s) {
+        s = splitmix64(seed);
+        seed += 0x9e3779b97f4a7c15ULL;
+    }
+}
+
+auto Rng::stream(std::uint64_t seed, std::uint64_t stream) -> Rng {
+    return Rng(seed ^ splitmix64(stream + 1));
+}
+
+auto Rng::uniform_int(int lower, int upper) -> int {
+    if (lower > upper) {
+        throw std::runtime_error("Rng::uniform_int: lower > upper");
+    }
+    const std::uint64_t range =
+        static_cast<std::uint64_t>(static_cast<std::int64_t>(upper) - lower) +
+        1;
+    __uint128_t m = static_cast<__uint128_t>(next()) * range;
+    auto low = static_cast<std::uint64_t>(m);
+    if (low < range) {
+        const std::uint64_t threshold = (0 - range) % range;
+        while (low < threshold) {
+            m = static_cast<__uint128_t>(next()) * range;
+            low = static_cast<std::uint64_t>(m);
+        }
+    }
+    return static_cast<int>(lower + static_cast<std::int64_t>(m >> 64));
+}
+
+auto Rng::normal(double mean, double stddev) -> double {
+    if (m_has_spare) {
+        m_has_spare = false;
+        return mean + stddev * m_spare;
+    }
+    double u, v, s;
+    do {
+        u = 2.0 * uniform01() - 1.0;
+        v = 2.0 * uniform01() - 1.0;
+        s = u * u + v * v;
+    } while (s >= 1.0 || s == 0.0);
+    double scale = std::sqrt(-2.0 * std::log(s) / s);
+    m_spare = v * scale;
+    m_has_spare = true;
+    return mean + stddev * u * scale;
+}
+
+namespace {
+
+// 种子、纪元与流编号由 g_mutex 一起发布，local 在慢路径上成对读取，
+// 不会读到新纪元配旧种子；g_epoch 另存一份原子副本供快路径比较
+std::mutex g_mutex;
+std::uint64_t g_seed = RNG_DEFAULT_SEED;
+std::uint64_t g_next_stream = 0;
+std::atomic<std::uint64_t> g_epoch{1};
+
+struct LocalRng {
+    Rng rng;
+    std::uint64_t epoch = 0;
+};
+thread_local LocalRng t_local;
+
+} // namespace
+
+auto RngService::set_seed(std::uint64_t seed) -> void {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_seed = seed;
+    g_next_stream = 1;
+    t_local.rng = Rng::stream(seed, 0);
+    t_local.epoch = g_epoch.load(std::memory_order_relaxed) + 1;
+    g_epoch.store(t_local.epoch, std::memory_order_release);
+}
+
+auto RngService::seed() -> std::uint64_t {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_seed;
+}
+
+auto RngService::local() -> Rng & {
+    if (t_local.epoch == g_epoch.load(std::memory_order_acquire)) {
+        return t_local.rng;
+    }
+    std::lock_guard<std::mutex> lock(g_mutex);
+    t_local.rng = Rng::stream(g_seed, g_next_stream++);
+    t_local.epoch = g_epoch.load(std::memory_order_relaxed);
+    return t_local.rng;
+}
+
+} // namespace seu
@@ -0,0 +1,715 @@
+#include "sim/pr_simulator.h"
+#include "milp_solver_interface.h"
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace seu {
+
+namespace {
+
+enum class EventType : std::uint8_t {
+    READY,
+    CONFIG_DONE,
+    EXEC_DONE,
+    CANCEL_DONE // 中止预取后 ICAP 空闲
+};
+
+struct Event {
+    double time;
+    std::uint64_t seq;
+    EventType type;
+    int job;             // READY
+    int partition;       // CONFIG_DONE / EXEC_DONE / CANCEL_DONE
+    std::uint64_t token; // CONFIG_DONE：与分区当前的不同时表示配置已中止
+};
+
+// 小顶堆：时刻早的在前，同一时刻按产生顺序
+struct EventLater {
+    auto operator()(const Event &a, const Event &b) const -> bool {
+        return a.time > b.time || (a.time == b.time && a.seq > b.seq);
+    }
+};
+
+// 分区的就绪队列：priority 小的在前，相同时按就绪顺序
+struct ReadyEntry {
+    double key;
+    std::uint64_t seq;
+    int job;
+};
+struct ReadyLater {
+    auto operator()(const ReadyEntry &a, const ReadyEntry &b) const -> bool {
+        return a.key > b.key || (a.key == b.key && a.seq > b.seq);
+    }
+};
+
+// ICAP 的请求队列：真正的配置请求先于预取；token 与分区当前的 token 不同
+// 时表示请求已被取消
+struct IcapEntry {
+    bool speculative;
+    double key;
+    std::uint64_t seq;
+    int partition;
+    std::uint64_t token;
+};
+struct IcapLater {
+    auto operator()(const IcapEntry &a, const IcapEntry &b) const -> bool {
+        if (a.speculative != b.speculative) {
+            return a.speculative;
+        }
+        return a.key > b.key || (a.key == b.key && a.seq > b.seq);
+    }
+};
+
+// 分区中某个模块的就绪作业：jobs 中已开始的作业延迟删除，waiting 为
+// 其中尚未开始的个数
+struct RowQueue {
+    std::deque<int> jobs;
+    long waiting = 0;
+};
+
+auto fits(const SimPartition &p, int clb, int dsp, int bram) -> bool {
+    return clb <= p.clb && dsp <= p.dsp && bram <= p.bram;
+}
+
+} // namespace
+
+auto SimConfig::from_solver(const param_from_solver &solution,
+                            const Platform &platform) -> SimConfig {
+    SimConfig config;
+    for (int k = 0; k < solution.num_partition; ++k) {
+        config.partitions.push_back({(*solution.clb_from_solver)[k],
+                                     (*solution.bram_from_solver)[k],
+                                     (*solution.dsp_from_solver)[k]});
+        for (auto row : (*solution.task_alloc)[k].task_id) {
+            if (row >= static_cast<int>(config.allocation.size())) {
+                config.allocation.resize(row + 1, -1);
+            }
+            config.allocation[row] = k;
+        }
+    }
+    config.rec_time_per_unit = platform.recTimePerUnit;
+    return config;
+}
+
+auto SimConfig::from_solver(const param_from_solver &solution,
+                            const param_to_solver &problem) -> SimConfig {
+    if (problem.task_set == nullptr || problem.platform == nullptr ||
+        problem.slacks == nullptr) {
+        throw std::runtime_error("Solver input has no task set or slacks");
+    }
+    SimConfig config = from_solver(solution, *problem.platform);
+    const Taskset &t = *problem.task_set;
+    config.slacks.assign(t.maxHW_Tasks, NO_DEADLINE);
+    for (unsigned i = 0; i < t.maxSW_Tasks; ++i) {
+        for (auto a : t.SW_Tasks[i].H) {
+            config.slacks.at(a) =
+                std::min(config.slacks[a], problem.slacks->at(i));
+        }
+    }
+    return config;
+}
+
+PrSimulator::PrSimulator(const TaskTable &tasks, SimConfig config)
+    : m_tasks(tasks), m_config(std::move(config)),
+      m_scheduler(std::make_shared<FifoScheduler>()) {
+    const auto &parts = m_config.partitions;
+    const auto &rt = m_config.rec_time_per_unit;
+    if (parts.empty()) {
+        throw std::runtime_error("PrSimulator needs at least one partition");
+    }
+    if (rt.size() <= DSP) {
+        throw std::runtime_error("PrSimulator needs CLB/BRAM/DSP rec times");
+    }
+    for (const auto &p : parts) {
+        m_rec_time.push_back(p.clb * rt[CLB] + p.bram * rt[BRAM] +
+                             p.dsp * rt[DSP]);
+    }
+
+    auto clb = tasks.clb();
+    auto dsp = tasks.dsp();
+    auto bram = tasks.bram();
+    auto exec = tasks.exec();
+    std::vector<long> load(parts.size(), 0);
+    m_partition_of.assign(tasks.size(), -1);
+    if (m_config.placement == Placement::CACHE) {
+        m_fitting.assign(tasks.size(), {});
+    }
+    for (std::size_t row = 0; row < tasks.size(); ++row) {
+        for (std::size_t p = 0; p < parts.size() && !m_fitting.empty(); ++p) {
+            if (fits(parts[p], clb[row], dsp[row], bram[row])) {
+                m_fitting[row].push_back(static_cast<int>(p));
+            }
+        }
+        int chosen = row < m_config.allocation.size()
+                         ? m_config.allocation[row]
+                         : -1;
+        if (chosen >= static_cast<int>(parts.size())) {
+            throw std::runtime_error("Allocation refers to missing partition");
+        }
+        // 未指定时选配置时间最短的分区，相同时选已分配执行时间最少的
+        if (chosen < 0) {
+            for (std::size_t p = 0; p < parts.size(); ++p) {
+                if (!fits(parts[p], clb[row], dsp[row], bram[row])) {
+                    continue;
+                }
+                if (chosen < 0 || m_rec_time[p] < m_rec_time[chosen] ||
+                    (m_rec_time[p] == m_rec_time[chosen] &&
+                     load[p] < load[chosen])) {
+                    chosen = static_cast<int>(p);
+                }
+            }
+        }
+        if (chosen < 0 || !fits(parts[chosen], clb[row], dsp[row], bram[row])) {
+            throw std::runtime_error("Task " +
+                                     std::to_string(tasks.ids()[row]) +
+                                     " does not fit its partition");
+        }
+        m_partition_of[row] = chosen;
+        load[chosen] += exec[row];
+    }
+}
+
+auto PrSimulator::run(const std::vector<SimJob> &jobs) -> SimReport {
+    return simulate(jobs, false);
+}
+
+auto PrSimulator::run_graph() -> SimReport {
+    std::vector<SimJob> jobs(m_tasks.size());
+    for (std::size_t row = 0; row < jobs.size(); ++row) {
+        jobs[row].row = static_cast<int>(row);
+    }
+    return simulate(jobs, true);
+}
+
+auto PrSimulator::simulate(const std::vector<SimJob> &jobs, bool dependencies)
+    -> SimReport {
+    const std::size_t num_jobs = jobs.size();
+    const std::size_t num_parts = m_config.partitions.size();
+    for (const auto &job : jobs) {
+        if (job.row < 0 ||
+            static_cast<std::size_t>(job.row) >= m_tasks.size()) {
+            throw std::runtime_error("SimJob refers to a missing task row");
+        }
+    }
+    auto exec = m_tasks.exec();
+    const Scheduler &sched = *m_scheduler;
+    const bool prefer_loaded = sched.prefer_loaded();
+    const bool prefetch = sched.prefetch();
+
+    SimReport report;
+    report.finish.assign(num_jobs, 0.0);
+    report.partition_busy.assign(num_parts, 0.0);
+    m_status.assign(num_jobs, TaskStatus::WAITING);
+
+    std::vector<SchedJob> info(num_jobs);
+    for (std::size_t j = 0; j < num_jobs; ++j) {
+        info[j].job = static_cast<int>(j);
+        info[j].row = jobs[j].row;
+        info[j].release = jobs[j].release;
+        if (static_cast<std::size_t>(jobs[j].row) < m_config.slacks.size()) {
+            info[j].deadline = jobs[j].release + m_config.slacks[jobs[j].row];
+        }
+    }
+
+    std::vector<Event> heap;
+    std::uint64_t seq = 0;
+    auto push = [&](double time, EventType type, int job, int partition,
+                    std::uint64_t token = 0) {
+        heap.push_back({time, seq++, type, job, partition, token});
+        std::push_heap(heap.begin(), heap.end(), EventLater());
+    };
+
+    // 没有依赖的作业按释放时刻排序后逐个进入事件表，事件表只保存在途的事件
+    std::vector<int> remaining(num_jobs, 0);
+    std::vector<int> arrivals;
+    arrivals.reserve(num_jobs);
+    for (std::size_t j = 0; j < num_jobs; ++j) {
+        if (dependencies) {
+            remaining[j] = static_cast<int>(m_tasks.parents(j).size());
+        }
+        if (remaining[j] == 0) {
+            arrivals.push_back(static_cast<int>(j));
+        }
+    }
+    std::stable_sort(arrivals.begin(), arrivals.end(), [&](int a, int b) {
+        return jobs[a].release < jobs[b].release;
+    });
+    std::size_t next_arrival = 0;
+
+    // 作业预计的先后：按 (释放时刻, 拓扑层次) 排列，供预取和 Belady 使用
+    const bool belady = m_config.placement == Placement::CACHE &&
+                        m_config.eviction == EvictionPolicy::BELADY;
+    std::vector<int> by_key;
+    if (prefetch || belady) {
+        std::vector<int> level(num_jobs, 0);
+        if (dependencies) {
+            std::vector<int> indegree(remaining);
+            std::vector<int> order(arrivals);
+            for (std::size_t head = 0; head < order.size(); ++head) {
+                for (auto child : m_tasks.children(order[head])) {
+                    level[child] = std::max(level[child],
+                                            level[order[head]] + 1);
+                    if (--indegree[child] == 0) {
+                        order.push_back(child);
+                    }
+                }
+            }
+        }
+        by_key.resize(num_jobs);
+        std::iota(by_key.begin(), by_key.end(), 0);
+        std::stable_sort(by_key.begin(), by_key.end(), [&](int a, int b) {
+            return jobs[a].release < jobs[b].release ||
+                   (jobs[a].release == jobs[b].release && level[a] < level[b]);
+        });
+    }
+
+    // 独立作业的预取候选：每个分区的作业按预计的先后排列，游标跳过已经就绪
+    // 的作业，均摊 O(1)
+    const bool dag_prefetch = prefetch && dependencies;
+    std::vector<std::vector<int>> upcoming(
+        prefetch && !dependencies ? num_parts : 0);
+    std::vector<std::size_t> upcoming_pos(upcoming.size(), 0);
+    for (std::size_t i = 0; !upcoming.empty() && i < by_key.size(); ++i) {
+        upcoming[m_partition_of[jobs[by_key[i]].row]].push_back(by_key[i]);
+    }
+    // DAG 的预取候选：尚未开始运行的父任务数降为 0 时，作业必定在其父任务
+    // 全部完成后就绪，按预计就绪时刻进入所在分区的堆
+    std::vector<int> not_running(dag_prefetch ? num_jobs : 0);
+    std::vector<double> predicted(not_running.size(), 0.0);
+    std::vector<std::vector<ReadyEntry>> imminent(dag_prefetch ? num_parts
+                                                               : 0);
+    for (std::size_t j = 0; j < not_running.size(); ++j) {
+        not_running[j] = remaining[j];
+    }
+
+    // Belady：每个模块的作业按预计的先后排列，第一个未开始的作业即下一次使用
+    std::vector<std::vector<int>> occurrences(belady ? m_tasks.size() : 0);
+    std::vector<std::size_t> occurrence_pos(occurrences.size(), 0);
+    std::vector<std::size_t> rank(belady ? num_jobs : 0);
+    for (std::size_t i = 0; belady && i < by_key.size(); ++i) {
+        occurrences[jobs[by_key[i]].row].push_back(by_key[i]);
+        rank[by_key[i]] = i;
+    }
+
+    std::vector<std::vector<ReadyEntry>> ready(num_parts);
+    // 分区 -> 模块 -> 该分区中该模块的就绪作业，供 prefer_loaded 使用
+    std::vector<std::unordered_map<int, RowQueue>> ready_by_row(
+        prefer_loaded ? num_parts : 0);
+    // CACHE：未命中且没有空闲分区的作业暂不分配，进入每个能容纳它的分区的
+    // 候选堆；pending_rows 按模块记录这些作业，某个分区开始配置该模块时
+    // 一并转入该分区
+    const bool cache = m_config.placement == Placement::CACHE;
+    std::vector<std::vector<ReadyEntry>> pending(cache ? num_parts : 0);
+    std::vector<std::vector<int>> pending_rows(cache ? m_tasks.size() : 0);
+    std::vector<char> is_ready(num_jobs, 0);
+    std::vector<char> taken(num_jobs, 0);
+    std::vector<int> placed(num_jobs, -1);
+    std::uint64_t ready_seq = 0;
+
+    std::vector<int> current(num_parts, -1);       // 分区正在处理的作业
+    std::vector<int> loaded(num_parts, -1);        // 分区中的模块（行号）
+    std::vector<int> prefetch_row(num_parts, -1);  // 正在预取的模块
+    std::vector<char> prefetched(num_parts, 0);    // 当前模块来自预取
+    std::vector<char> configuring(num_parts, 0);
+    std::vector<std::uint64_t> token(num_parts, 0);
+    std::vector<std::uint64_t> config_token(num_parts, 0);
+    std::vector<double> config_end(num_parts, 0.0);
+    std::vector<int> wake; // 出现预取候选、需要重新决策的分区
+    std::vector<long> queued(num_parts, 0);      // 分区中就绪未开始的作业
+    std::vector<std::uint64_t> last_used(num_parts, 0);
+    std::vector<long> uses(m_tasks.size(), 0);
+    std::uint64_t use_clock = 0;
+    std::vector<IcapEntry> icap;
+    bool icap_busy = false;
+    double now = 0.0;
+
+    auto start_exec = [&](int p) {
+        int job = current[p];
+        m_status[job] = TaskStatus::RUNNING;
+        report.partition_busy[p] += exec[jobs[job].row];
+        push(now + exec[jobs[job].row], EventType::EXEC_DONE, -1, p);
+        if (!dag_prefetch) {
+            return;
+        }
+        for (auto child : m_tasks.children(jobs[job].row)) {
+            predicted[child] =
+                std::max(predicted[child], now + exec[jobs[job].row]);
+            if (--not_running[child] == 0) {
+                const int cp = m_partition_of[jobs[child].row];
+                imminent[cp].push_back({predicted[child], seq++, child});
+                std::push_heap(imminent[cp].begin(), imminent[cp].end(),
+                               ReadyLater());
+                wake.push_back(cp);
+            }
+        }
+    };
+    auto start_icap = [&]() {
+        while (!icap_busy && !icap.empty()) {
+            std::pop_heap(icap.begin(), icap.end(), IcapLater());
+            IcapEntry request = icap.back();
+            icap.pop_back();
+            const int p = request.partition;
+            if (request.token != token[p]) {
+                continue;
+            }
+            icap_busy = true;
+            configuring[p] = 1;
+            if (current[p] >= 0) {
+                m_status[current[p]] = TaskStatus::CONFIGURING;
+            } else {
+                report.prefetches++;
+            }
+            report.prefetch_wasted += prefetched[p];
+            loaded[p] = -1;
+            prefetched[p] = 0;
+            report.icap_busy += m_rec_time[p];
+            report.partition_busy[p] += m_rec_time[p];
+            report.reconfigurations++;
+            config_end[p] = now + m_rec_time[p];
+            push(config_end[p], EventType::CONFIG_DONE, -1, p,
+                 ++config_token[p]);
+        }
+    };
+    auto request_icap = [&](int p, bool speculative, double key) {
+        icap.push_back({speculative, key, seq++, p, ++token[p]});
+        std::push_heap(icap.begin(), icap.end(), IcapLater());
+        start_icap();
+    };
+    auto enqueue = [&](int p, int job) {
+        placed[job] = p;
+        queued[p]++;
+        ready[p].push_back(
+            {sched.priority(info[job]), info[job].ready_seq, job});
+        std::push_heap(ready[p].begin(), ready[p].end(), ReadyLater());
+        if (prefer_loaded) {
+            auto &same = ready_by_row[p][jobs[job].row];
+            same.jobs.push_back(job);
+            same.waiting++;
+        }
+    };
+    auto take = [&](int p, int job) {
+        taken[job] = 1;
+        queued[p]--;
+        if (prefer_loaded) {
+            auto &same = ready_by_row[p][jobs[job].row];
+            if (--same.waiting == 0) {
+                same.jobs.clear();
+            }
+        }
+    };
+    auto pop_ready = [&](int p) -> int {
+        if (prefer_loaded && loaded[p] >= 0) {
+            auto it = ready_by_row[p].find(loaded[p]);
+            if (it != ready_by_row[p].end() && it->second.waiting > 0) {
+                auto &same = it->second.jobs;
+                while (taken[same.front()]) {
+                    same.pop_front();
+                }
+                int job = same.front();
+                same.pop_front();
+                take(p, job);
+                return job;
+            }
+        }
+        auto &q = ready[p];
+        while (!q.empty()) {
+            std::pop_heap(q.begin(), q.end(), ReadyLater());
+            int job = q.back().job;
+            q.pop_back();
+            if (!taken[job]) {
+                take(p, job);
+                return job;
+            }
+        }
+        return -1;
+    };
+    // CACHE：分区空闲且没有本分区的作业时，领取优先级最高的未分配作业，
+    // 此时才替换分区中的模块
+    auto pop_pending = [&](int p) -> int {
+        auto &q = pending[p];
+        while (!q.empty()) {
+            std::pop_heap(q.begin(), q.end(), ReadyLater());
+            int job = q.back().job;
+            q.pop_back();
+            if (placed[job] < 0) {
+                placed[job] = p;
+                taken[job] = 1;
+                return job;
+            }
+        }
+        return -1;
+    };
+    // 分区 p 开始配置模块 row，等待该模块的未分配作业随之命中
+    auto claim = [&](int p, int row) {
+        for (auto job : pending_rows[row]) {
+            if (placed[job] < 0) {
+                enqueue(p, job);
+            }
+        }
+        pending_rows[row].clear();
+    };
+    auto start_prefetch = [&](int p) {
+        if (dag_prefetch) {
+            auto &q = imminent[p];
+            while (!q.empty() && is_ready[q.front().job]) {
+                std::pop_heap(q.begin(), q.end(), ReadyLater());
+                q.pop_back();
+            }
+            if (!q.empty() && jobs[q.front().job].row != loaded[p]) {
+                prefetch_row[p] = jobs[q.front().job].row;
+                request_icap(p, true, 0.0);
+            }
+            return;
+        }
+        auto &list = upcoming[p];
+        auto &pos = upcoming_pos[p];
+        while (pos < list.size() && is_ready[list[pos]]) {
+            pos++;
+        }
+        if (pos == list.size() || jobs[list[pos]].row == loaded[p]) {
+            return;
+        }
+        prefetch_row[p] = jobs[list[pos]].row;
+        request_icap(p, true, 0.0);
+    };
+    // 分区正在预取的模块不是它下一个就绪作业所需的
+    auto mispredicted = [&](int p) {
+        if (prefer_loaded) {
+            auto it = ready_by_row[p].find(prefetch_row[p]);
+            return it == ready_by_row[p].end() || it->second.waiting == 0;
+        }
+        auto &q = ready[p];
+        while (!q.empty() && taken[q.front().job]) {
+            std::pop_heap(q.begin(), q.end(), ReadyLater());
+            q.pop_back();
+        }
+        return !q.empty() && jobs[q.front().job].row != prefetch_row[p];
+    };
+    auto start_next = [&](int p) {
+        if (current[p] >= 0) {
+            return;
+        }
+        if (prefetch_row[p] >= 0) {
+            if (queued[p] == 0) {
+                return;
+            }
+            if (!configuring[p]) {
+                // 预取还在排队，直接撤销
+                prefetch_row[p] = -1;
+                token[p]++;
+            } else if (!mispredicted(p) || !m_config.prefetch_cancel ||
+                       config_end[p] - now <= m_config.prefetch_cancel_cost) {
+                // 预取的模块正是就绪作业所需，或中止不划算：等它完成
+                return;
+            } else {
+                // 中止预取：ICAP 再忙 prefetch_cancel_cost，未完成的部分
+                // 不计入配置时间
+                const double left = config_end[p] - now;
+                report.icap_busy -= left - m_config.prefetch_cancel_cost;
+                report.partition_busy[p] -= left;
+                report.prefetch_cancels++;
+                report.prefetch_wasted++;
+                config_token[p]++;
+                configuring[p] = 0;
+                prefetch_row[p] = -1;
+                push(now + m_config.prefetch_cancel_cost,
+                     EventType::CANCEL_DONE, -1, p);
+            }
+        }
+        int job = pop_ready(p);
+        if (job < 0 && cache) {
+            job = pop_pending(p);
+        }
+        if (job < 0) {
+            if (prefetch) {
+                start_prefetch(p);
+            }
+            return;
+        }
+        current[p] = job;
+        last_used[p] = ++use_clock;
+        uses[jobs[job].row]++;
+        if (loaded[p] == jobs[job].row) {
+            if (prefetched[p]) {
+                report.prefetch_hits++;
+            } else {
+                report.cache_hits++;
+                report.rec_time_saved += m_rec_time[p];
+            }
+            prefetched[p] = 0;
+            start_exec(p);
+        } else {
+            if (cache) {
+                claim(p, jobs[job].row);
+            }
+            request_icap(p, false, sched.priority(info[job]));
+        }
+    };
+
+    // 分区中已配置或正在配置的模块
+    auto module_of = [&](int p) {
+        if (!configuring[p]) {
+            return loaded[p];
+        }
+        return current[p] >= 0 ? jobs[current[p]].row : prefetch_row[p];
+    };
+    auto next_use = [&](int row) -> double {
+        auto &list = occurrences[row];
+        auto &pos = occurrence_pos[row];
+        while (pos < list.size() && taken[list[pos]]) {
+            pos++;
+        }
+        return pos < list.size() ? static_cast<double>(rank[list[pos]])
+                                 : NO_DEADLINE;
+    };
+    // 越小越应该被替换
+    auto victim_score = [&](int p) -> double {
+        const int row = module_of(p);
+        if (row < 0) {
+            return -NO_DEADLINE;
+        }
+        switch (m_config.eviction) {
+        case EvictionPolicy::LFU:
+            return static_cast<double>(uses[row]);
+        case EvictionPolicy::BELADY:
+            return -next_use(row);
+        case EvictionPolicy::LRU:
+        default:
+            return static_cast<double>(last_used[p]);
+        }
+    };
+    // 作业就绪时所在的分区；CACHE 时未命中且没有空闲分区返回 -1，
+    // 等分区空闲后再决定替换哪个模块
+    auto place = [&](int job) -> int {
+        const int row = jobs[job].row;
+        if (!cache) {
+            return m_partition_of[row];
+        }
+        const auto &fitting = m_fitting[row];
+        for (auto p : fitting) {
+            if (module_of(p) == row) {
+                return p;
+            }
+        }
+        int best = -1;
+        double best_score = 0.0;
+        for (auto p : fitting) {
+            if (current[p] >= 0 || configuring[p] || queued[p] > 0) {
+                continue;
+            }
+            const double score = victim_score(p);
+            if (best < 0 || score < best_score) {
+                best = p;
+                best_score = score;
+            }
+        }
+        return best;
+    };
+
+    while (next_arrival < arrivals.size() || !heap.empty()) {
+        Event e;
+        // 同一时刻已在事件表中的事件先于新到达的作业处理
+        if (next_arrival < arrivals.size() &&
+            (heap.empty() || jobs[arrivals[next_arrival]].release <
+                                 heap.front().time)) {
+            int job = arrivals[next_arrival++];
+            e = {jobs[job].release, 0, EventType::READY, job, -1, 0};
+        } else {
+            std::pop_heap(heap.begin(), heap.end(), EventLater());
+            e = heap.back();
+            heap.pop_back();
+        }
+        now = std::max(now, e.time);
+        report.events++;
+
+        switch (e.type) {
+        case EventType::READY: {
+            const int row = jobs[e.job].row;
+            const int p = place(e.job);
+            info[e.job].ready_seq = ready_seq++;
+            is_ready[e.job] = 1;
+            if (p < 0) {
+                for (auto q : m_fitting[row]) {
+                    pending[q].push_back({sched.priority(info[e.job]),
+                                          info[e.job].ready_seq, e.job});
+                    std::push_heap(pending[q].begin(), pending[q].end(),
+                                   ReadyLater());
+                }
+                pending_rows[row].push_back(e.job);
+                break;
+            }
+            enqueue(p, e.job);
+            start_next(p);
+            break;
+        }
+        case EventType::CONFIG_DONE: {
+            const int p = e.partition;
+            if (e.token != config_token[p]) {
+                break;
+            }
+            icap_busy = false;
+            configuring[p] = 0;
+            if (current[p] >= 0) {
+                loaded[p] = jobs[current[p]].row;
+                start_exec(p);
+            } else {
+                loaded[p] = prefetch_row[p];
+                prefetch_row[p] = -1;
+                prefetched[p] = 1;
+                start_next(p);
+            }
+            start_icap();
+            break;
+        }
+        case EventType::EXEC_DONE: {
+            const int p = e.partition;
+            const int job = current[p];
+            m_status[job] = TaskStatus::ENDING;
+            report.finish[job] = now;
+            if (now > info[job].deadline) {
+                report.deadline_misses++;
+            }
+            current[p] = -1;
+            if (dependencies) {
+                for (auto child : m_tasks.children(jobs[job].row)) {
+                    if (--remaining[child] == 0) {
+                        push(std::max(now, jobs[child].release),
+                             EventType::READY, child, -1);
+                    }
+                }
+            }
+            start_next(p);
+            break;
+        }
+        case EventType::CANCEL_DONE:
+            icap_busy = false;
+            start_icap();
+            break;
+        }
+        while (!wake.empty()) {
+            const int p = wake.back();
+            wake.pop_back();
+            start_next(p);
+        }
+    }
+
+    report.makespan = now;
+    report.icap_utilization = now > 0.0 ? report.icap_busy / now : 0.0;
+    report.throughput = now > 0.0 ? num_jobs / now : 0.0;
+    report.hit_rate =
+        num_jobs > 0 ? static_cast<double>(report.cache_hits) / num_jobs : 0.0;
+    report.partition_idle.resize(num_parts);
+    for (std::size_t p = 0; p < num_parts; ++p) {
+        report.partition_idle[p] = now - report.partition_busy[p];
+    }
+    report.unfinished = std::count_if(
+        m_status.begin(), m_status.end(),
+        [](TaskStatus s) { return s != TaskStatus::ENDING; });
+    return report;
+}
+
+} // namespace seu
@@ -0,0 +1,19 @@
+#include "sim/scheduler.h"
+
+namespace seu {
+
+auto make_scheduler(SchedulePolicy policy) -> SchedulerRef {
+    switch (policy) {
+    case SchedulePolicy::EDF:
+        return std::make_shared<EdfScheduler>();
+    case SchedulePolicy::LEAST_RECONFIG:
+        return std::make_shared<LeastReconfigScheduler>();
+    case SchedulePolicy::PREFETCH:
+        return std::make_shared<PrefetchScheduler>();
+    case SchedulePolicy::FIFO:
+    default:
+        return std::make_shared<FifoScheduler>();
+    }
+}
+
+} // namespace seu
@@ -4,12 +4,38 @@
 #include "milp_solver_interface.h"
 #include "pynq/pynq_fine_grained.h"
 #include <memory>
+#include <stdexcept>
 #include <yaml-cpp/yaml.h>
 
 namespace seu {
 
 extern YAML::Node config;
 
+namespace {
+
+// dart.objective：wasted_clb / wasted_bram / wasted_dsp / wirelength 的权重，
+// priority 为 weighted（默认）、wasted_first 或 wirelength_first
+auto read_objective(const YAML::Node &node) -> pynq_objective {
+    pynq_objective objective;
+    if (!node)
+        return objective;
+    objective.wasted_clb = node["wasted_clb"].as<double>(objective.wasted_clb);
+    objective.wasted_bram =
+        node["wasted_bram"].as<double>(objective.wasted_bram);
+    objective.wasted_dsp = node["wasted_dsp"].as<double>(objective.wasted_dsp);
+    objective.wirelength = node["wirelength"].as<double>(objective.wirelength);
+    auto priority = node["priority"].as<std::string>("weighted");
+    if (priority == "wasted_first")
+        objective.priority = pynq_priority::WASTED_FIRST;
+    else if (priority == "wirelength_first")
+        objective.priority = pynq_priority::WIRELENGTH_FIRST;
+    else if (priority != "weighted")
+        throw std::runtime_error("Unknown objective priority " + priority);
+    return objective;
+}
+
+} // namespace
+
 char const *fpga_board_name[] = {
     "Zybo board", "Pynq board", "ultrascale ZCU-102 board", "ultra96-v2 board"};
 
@@ -103,7 +129,7 @@ void floorplan::start_optimizer() {
         task_set->HW_Tasks[i].resDemand[BRAM] = bram_vector[i];
         task_set->HW_Tasks[i].resDemand[DSP] = dsp_vector[i];
         task_set->HW_Tasks[i].WCET = HW_WCET[i];
-        task_set->SW_Tasks[i].H.push_back(i);
+        task_set->SW_Tasks[i].H.assign(1, i);
         task_set->HW_Tasks[i].SW_Task_ID = i;
     }
 
@@ -119,7 +145,9 @@ void floorplan::start_optimizer() {
     param->slacks = &slacks;
 
     pynq_inst = std::make_shared<pynq>();
-    solver = std::make_shared<milp_solver_pynq>();
+    // 复用同一个求解器，连续的布局只更新模型数据（见 milp_session_pynq）
+    if (!solver)
+        solver = std::make_shared<milp_solver_pynq>();
     for (i = 0; i < pynq_inst->m_num_forbidden_slots; i++) {
         forbidden_region[i] = pynq_inst->forbidden_pos[i];
         // cout<< " fbdn" << forbidden_region[i].x << endl;
@@ -142,6 +170,22 @@ void floorplan::start_optimizer() {
     platform->recTimePerUnit[BRAM] = 1.0 / 4500.0;
     platform->recTimePerUnit[DSP] = 1.0 / 4000.0;
 
+    // dart.formulation：legacy（默认）或 tight，见 pynq_formulation
+    // solver 可以在外部替换成其他 milp_solver_interface，只有 PYNQ 求解器
+    // 支持这些选项
+    auto pynq_solver = std::dynamic_pointer_cast<milp_solver_pynq>(solver);
+    if (!pynq_solver)
+        throw std::runtime_error("floorplan needs a milp_solver_pynq");
+    auto &ctx = pynq_solver->context();
+    ctx.weights = read_objective(config["dart"]["objective"]);
+    auto formulation = config["dart"]["formulation"].as<std::string>("legacy");
+    if (formulation == "tight")
+        ctx.formulation = pynq_formulation::TIGHT;
+    else if (formulation == "legacy")
+        ctx.formulation = pynq_formulation::LEGACY;
+    else
+        throw std::runtime_error("Unknown formulation " + formulation);
+
     cout << "FLORA: starting PYNQ MILP optimizer " << endl;
     solver->start_optimizer(from_solver, param);
     cout << "FLORA: finished MILP optimizer " << endl;
@@ -170,7 +214,6 @@ vector<int> floorplan::get_units_per_task(int n, int n_units, int n_min,
     uint n_units_sum = n_units, n_units_next = 0;
 
     for (uint i = 0; i < (uint)n - 1; i++) {
-        srand(time(0));
         rand_dbl = pow(MY_RAND(), (1.0 / (double)(n - i - 1)));
         n_units_next = floor((double)n_units_sum * rand_dbl);
         // cout << n_units_next << " " << rand_dbl << endl;
@@ -0,0 +1,495 @@
+#include "solver/floorplan_dse.h"
+#include "pynq/pynq.h"
+#include "rng.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+namespace seu {
+
+namespace {
+
+// output 的第一行为格式版本与输入的指纹（16 位十六进制），第二行为列名。
+// 版本 1（10 列，没有 priority 与解中各项的值）与版本 2（15 列，没有
+// formulation）没有版本行；其中 LEGACY 的结果是修正约束 2.0.1 之前求得的，
+// 不能直接续用，因此不做迁移，load 遇到旧格式时报错。版本 3 没有指纹，
+// 无法确认输入相同，同样报错
+constexpr const char *DSE_VERSION_PREFIX = "# seu floorplan_dse v";
+constexpr int DSE_VERSION = 4;
+constexpr const char *DSE_HEADER =
+    "num_modules,preemptive_FRI,formulation,priority,w_wasted_clb,"
+    "w_wasted_bram,w_wasted_dsp,w_wirelength,status,objective,partitions,"
+    "wasted_clb,wasted_bram,wasted_dsp,wirelength,seconds";
+constexpr std::size_t DSE_FIELDS = 16;
+
+auto split(const std::string &line) -> std::vector<std::string> {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+// 整个字段都能解析时返回 true
+template <typename T> auto parse(const std::string &s, T &value) -> bool {
+    std::istringstream in(s);
+    in >> value;
+    return !in.fail() && in.peek() == std::char_traits<char>::eof();
+}
+
+auto parse_line(const std::string &line, DseResult &result) -> bool {
+    auto f = split(line);
+    if (f.size() != DSE_FIELDS) {
+        return false;
+    }
+    auto &p = result.point;
+    auto &w = p.weights;
+    int fri = 0, formulation = 0, priority = 0;
+    if (!parse(f[0], p.num_modules) || !parse(f[1], fri) ||
+        !parse(f[2], formulation) || !parse(f[3], priority)) {
+        return false;
+    }
+    if (formulation < 0 ||
+        formulation > static_cast<int>(pynq_formulation::TIGHT) ||
+        priority < 0 ||
+        priority > static_cast<int>(pynq_priority::WIRELENGTH_FIRST)) {
+        return false;
+    }
+    p.preemptive_FRI = fri != 0;
+    p.formulation = static_cast<pynq_formulation>(formulation);
+    w.priority = static_cast<pynq_priority>(priority);
+    return parse(f[4], w.wasted_clb) && parse(f[5], w.wasted_bram) &&
+           parse(f[6], w.wasted_dsp) && parse(f[7], w.wirelength) &&
+           parse(f[8], result.status) && parse(f[9], result.objective) &&
+           parse(f[10], result.partitions) &&
+           parse(f[11], result.wasted_clb) &&
+           parse(f[12], result.wasted_bram) &&
+           parse(f[13], result.wasted_dsp) && parse(f[14], result.wirelength) &&
+           parse(f[15], result.seconds);
+}
+
+auto mix(std::uint64_t h, std::uint64_t value) -> std::uint64_t {
+    return splitmix64(h ^ value);
+}
+
+auto mix(std::uint64_t h, double value) -> std::uint64_t {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return mix(h, bits);
+}
+
+auto format_line(const DseResult &result) -> std::string {
+    const auto &p = result.point;
+    const auto &w = p.weights;
+    std::ostringstream out;
+    out.precision(17);
+    out << p.num_modules << ',' << p.preemptive_FRI << ','
+        << static_cast<int>(p.formulation) << ','
+        << static_cast<int>(w.priority) << ',' << w.wasted_clb << ','
+        << w.wasted_bram << ',' << w.wasted_dsp << ',' << w.wirelength << ','
+        << result.status << ',' << result.objective << ','
+        << result.partitions << ',' << result.wasted_clb << ','
+        << result.wasted_bram << ',' << result.wasted_dsp << ','
+        << result.wirelength << ',' << result.seconds;
+    return out.str();
+}
+
+} // namespace
+
+auto DsePoint::key() const -> std::string {
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "%d;%d;%d;%d;%.17g:%.17g:%.17g:%.17g",
+                  num_modules, preemptive_FRI ? 1 : 0,
+                  static_cast<int>(formulation),
+                  static_cast<int>(weights.priority), weights.wasted_clb,
+                  weights.wasted_bram, weights.wasted_dsp, weights.wirelength);
+    return buf;
+}
+
+auto DseSpace::grid() const -> std::vector<DsePoint> {
+    std::vector<DsePoint> points;
+    points.reserve(module_counts.size() * preemptive_FRI.size() *
+                   weights.size() * formulations.size());
+    for (auto n : module_counts) {
+        for (bool fri : preemptive_FRI) {
+            for (const auto &w : weights) {
+                for (auto f : formulations) {
+                    points.push_back({n, w, fri, f});
+                }
+            }
+        }
+    }
+    return points;
+}
+
+auto DseSpace::sample(std::size_t n, std::uint64_t seed) const
+    -> std::vector<DsePoint> {
+    if (module_counts.empty() || weights.empty() || preemptive_FRI.empty() ||
+        formulations.empty()) {
+        throw std::runtime_error("Empty dimension in DseSpace");
+    }
+    auto pick = [](Rng &rng, std::size_t size) {
+        return static_cast<std::size_t>(
+            rng.uniform_int(0, static_cast<int>(size) - 1));
+    };
+    Rng rng(seed);
+    std::vector<DsePoint> points(n);
+    for (auto &p : points) {
+        p.num_modules = module_counts[pick(rng, module_counts.size())];
+        p.preemptive_FRI = preemptive_FRI[pick(rng, preemptive_FRI.size())];
+        p.weights = weights[pick(rng, weights.size())];
+        p.formulation = formulations[pick(rng, formulations.size())];
+    }
+    return points;
+}
+
+floorplan_dse::floorplan_dse(std::vector<DseModule> modules,
+                             std::vector<std::vector<int>> connections,
+                             DseOptions options)
+    : m_modules(std::move(modules)), m_connections(std::move(connections)),
+      m_options(std::move(options)) {
+    if (m_connections.size() > MAX_SLOTS) {
+        throw std::runtime_error("Too many connections in floorplan_dse");
+    }
+    for (const auto &c : m_connections) {
+        if (c.size() < 3 || c[0] < 1 || c[1] < 1) {
+            throw std::runtime_error("Malformed connection in floorplan_dse");
+        }
+    }
+    if (m_options.threads_per_solve < 1) {
+        throw std::runtime_error("threads_per_solve must be positive");
+    }
+}
+
+auto floorplan_dse::fingerprint() const -> std::uint64_t {
+    std::uint64_t h = mix(DSE_VERSION, m_options.time_limit);
+    h = mix(h, static_cast<std::uint64_t>(m_modules.size()));
+    for (const auto &m : m_modules) {
+        h = mix(h, static_cast<std::uint64_t>(m.clb));
+        h = mix(h, static_cast<std::uint64_t>(m.bram));
+        h = mix(h, static_cast<std::uint64_t>(m.dsp));
+        h = mix(mix(h, m.wcet), m.slack);
+    }
+    h = mix(h, static_cast<std::uint64_t>(m_connections.size()));
+    for (const auto &c : m_connections) {
+        for (std::size_t i = 0; i < 3; ++i) {
+            h = mix(h, static_cast<std::uint64_t>(c[i]));
+        }
+    }
+    return h;
+}
+
+auto floorplan_dse::dedup(const std::vector<DsePoint> &points)
+    -> std::vector<DsePoint> {
+    std::vector<DsePoint> unique;
+    std::unordered_map<std::string, std::size_t> seen;
+    for (const auto &p : points) {
+        if (seen.emplace(p.key(), unique.size()).second) {
+            unique.push_back(p);
+        }
+    }
+    return unique;
+}
+
+auto floorplan_dse::load(const std::string &path,
+                         std::optional<std::uint64_t> fingerprint)
+    -> std::vector<DseResult> {
+    std::vector<DseResult> results;
+    std::ifstream in(path);
+    std::string line;
+    if (!std::getline(in, line)) {
+        return results;
+    }
+    const std::string prefix = DSE_VERSION_PREFIX;
+    int version = 0;
+    std::uint64_t written = 0;
+    std::istringstream version_line(line.compare(0, prefix.size(), prefix) == 0
+                                        ? line.substr(prefix.size())
+                                        : std::string());
+    if (!(version_line >> version)) {
+        throw std::runtime_error("DSE output " + path +
+                                 " has an older format without a version "
+                                 "line; move it away to start over");
+    }
+    if (version != DSE_VERSION) {
+        throw std::runtime_error("DSE output " + path + " has format v" +
+                                 std::to_string(version) + ", expected v" +
+                                 std::to_string(DSE_VERSION));
+    }
+    if (!(version_line >> std::hex >> written)) {
+        throw std::runtime_error("DSE output " + path +
+                                 " has no input fingerprint");
+    }
+    if (fingerprint && *fingerprint != written) {
+        throw std::runtime_error("DSE output " + path +
+                                 " was written for other modules, "
+                                 "connections or time limit; move it away "
+                                 "to start over");
+    }
+    while (std::getline(in, line)) {
+        DseResult result;
+        if (parse_line(line, result)) {
+            results.push_back(result);
+        }
+    }
+    return results;
+}
+
+auto floorplan_dse::run(const std::vector<DsePoint> &points)
+    -> std::vector<DseResult> {
+    const auto unique = dedup(points);
+    const int max_modules =
+        std::min<int>(static_cast<int>(m_modules.size()), MAX_SLOTS);
+    for (const auto &p : unique) {
+        if (p.num_modules < 1 || p.num_modules > max_modules) {
+            throw std::runtime_error("Module count out of range in DSE point");
+        }
+    }
+
+    std::unordered_map<std::string, std::size_t> index;
+    for (std::size_t i = 0; i < unique.size(); ++i) {
+        index.emplace(unique[i].key(), i);
+    }
+    std::vector<DseResult> results(unique.size());
+    std::vector<char> done(unique.size(), 0);
+    if (!m_options.output.empty()) {
+        for (const auto &r : load(m_options.output, fingerprint())) {
+            auto it = index.find(r.point.key());
+            if (it != index.end()) {
+                results[it->second] = r;
+                done[it->second] = 1;
+            }
+        }
+    }
+
+    // 同一模型结构的点相邻，便于工作线程复用模型
+    std::vector<std::size_t> todo;
+    for (std::size_t i = 0; i < unique.size(); ++i) {
+        if (!done[i]) {
+            todo.push_back(i);
+        }
+    }
+    std::stable_sort(todo.begin(), todo.end(),
+                     [&](std::size_t a, std::size_t b) {
+                         const auto &pa = unique[a], &pb = unique[b];
+                         return std::make_tuple(pa.num_modules,
+                                                pa.preemptive_FRI,
+                                                pa.formulation) <
+                                std::make_tuple(pb.num_modules,
+                                                pb.preemptive_FRI,
+                                                pb.formulation);
+                     });
+    if (todo.empty()) {
+        return results;
+    }
+
+    if (!m_options.output.empty()) {
+        // 上次崩溃时可能留下不以换行结尾的半行
+        bool fresh = true, newline = true;
+        {
+            std::ifstream in(m_options.output, std::ios::binary);
+            if (in && in.seekg(0, std::ios::end) && in.tellg() > 0) {
+                fresh = false;
+                in.seekg(-1, std::ios::end);
+                newline = in.get() == '\n';
+            }
+        }
+        m_out.open(m_options.output, std::ios::app);
+        if (!m_out) {
+            throw std::runtime_error("Cannot open DSE output " +
+                                     m_options.output);
+        }
+        if (!newline) {
+            m_out << '\n';
+        }
+        if (fresh) {
+            m_out << DSE_VERSION_PREFIX << DSE_VERSION << ' ' << std::hex
+                  << std::setw(16) << std::setfill('0') << fingerprint()
+                  << std::dec << std::setfill(' ') << '\n'
+                  << DSE_HEADER << '\n';
+        }
+        m_out.flush();
+    }
+
+    unsigned total = m_options.threads;
+    if (total == 0) {
+        total = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const unsigned per_solve = m_options.threads_per_solve;
+    const std::size_t workers =
+        std::min<std::size_t>(todo.size(), std::max(1u, total / per_solve));
+
+    std::atomic<std::size_t> next{0};
+    ThreadPool pool(workers);
+    std::vector<std::future<void>> futures;
+    for (std::size_t t = 0; t < workers; ++t) {
+        futures.push_back(pool.submit([&]() {
+            milp_solver_pynq solver;
+            solver.set_threads(m_options.threads_per_solve);
+            solver.context().time_limit = m_options.time_limit;
+            for (std::size_t i = next++; i < todo.size(); i = next++) {
+                const std::size_t row = todo[i];
+                try {
+                    results[row] = solve(solver, unique[row]);
+                } catch (const std::exception &e) {
+                    results[row] = DseResult();
+                    results[row].point = unique[row];
+                    results[row].status = DSE_FAILED;
+                    results[row].error = e.what();
+                    continue;
+                }
+                append(results[row]);
+            }
+        }));
+    }
+    for (auto &f : futures) {
+        f.get();
+    }
+    if (m_out.is_open()) {
+        m_out.close();
+    }
+    return results;
+}
+
+auto floorplan_dse::pareto(const DsePoint &point, std::size_t max_points)
+    -> std::vector<DseResult> {
+    if (point.num_modules < 1 ||
+        point.num_modules >
+            std::min<int>(static_cast<int>(m_modules.size()), MAX_SLOTS)) {
+        throw std::runtime_error("Module count out of range in DSE point");
+    }
+    DsePoint lex = point;
+    lex.weights.priority = pynq_priority::WASTED_FIRST;
+
+    unsigned threads = m_options.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    milp_solver_pynq solver;
+    solver.set_threads(static_cast<int>(threads));
+    solver.context().time_limit = m_options.time_limit;
+
+    std::vector<DseResult> front;
+    double bound = 1.0;
+    while (front.size() < max_points) {
+        auto result = solve(solver, lex, bound);
+        if (result.status != GRB_OPTIMAL ||
+            (!front.empty() &&
+             result.wirelength >= front.back().wirelength)) {
+            break;
+        }
+        front.push_back(std::move(result));
+        // 质心坐标为半格，归一化布线长度的最小变化为 0.5 / wl_max
+        const auto wl_max = solver.context().wl_max;
+        if (wl_max == 0 || front.back().wirelength <= 0) {
+            break;
+        }
+        bound = front.back().wirelength - 0.5 / wl_max;
+    }
+    return front;
+}
+
+auto floorplan_dse::solve(milp_solver_pynq &solver, const DsePoint &point,
+                          double wirelength_bound) -> DseResult {
+    const int n = point.num_modules;
+    Platform platform(3);
+    platform.maxFPGAResources[CLB] = PYNQ_CLB_TOT;
+    platform.maxFPGAResources[BRAM] = PYNQ_BRAM_TOT;
+    platform.maxFPGAResources[DSP] = PYNQ_DSP_TOT;
+    platform.recTimePerUnit[CLB] = 1.0 / 4500.0;
+    platform.recTimePerUnit[BRAM] = 1.0 / 4500.0;
+    platform.recTimePerUnit[DSP] = 1.0 / 4000.0;
+
+    Taskset task_set(n, n, platform);
+    vector<int> clb(MAX_SLOTS), bram(MAX_SLOTS), dsp(MAX_SLOTS);
+    vector<double> slacks(MAX_SLOTS);
+    for (int i = 0; i < n; i++) {
+        const auto &m = m_modules[i];
+        clb[i] = m.clb;
+        bram[i] = m.bram;
+        dsp[i] = m.dsp;
+        slacks[i] = m.slack;
+        task_set.HW_Tasks[i].resDemand[CLB] = m.clb;
+        task_set.HW_Tasks[i].resDemand[BRAM] = m.bram;
+        task_set.HW_Tasks[i].resDemand[DSP] = m.dsp;
+        task_set.HW_Tasks[i].WCET = m.wcet;
+        task_set.HW_Tasks[i].SW_Task_ID = i;
+        task_set.SW_Tasks[i].H.assign(1, i);
+    }
+
+    // 只保留两端都在前 n 个模块中的连接
+    Vec2d conn;
+    for (const auto &c : m_connections) {
+        if (c[0] <= n && c[1] <= n) {
+            conn.push_back(c);
+        }
+    }
+    const int num_conn = static_cast<int>(conn.size());
+    conn.resize(MAX_SLOTS, vector<int>(3, 0));
+
+    pynq board;
+    Vecpos forbidden(MAX_SLOTS);
+    for (int i = 0; i < board.m_num_forbidden_slots; i++) {
+        forbidden[i] = board.forbidden_pos[i];
+    }
+    auto param = std::make_shared<param_to_solver>(
+        n, board.m_num_forbidden_slots, board.m_num_rows, board.m_width,
+        num_conn, board.m_num_clk_reg / 2, PYNQ_CLB_PER_TILE,
+        PYNQ_BRAM_PER_TILE, PYNQ_DSP_PER_TILE, &clb, &bram, &dsp, &conn,
+        &forbidden, &task_set, &platform, &slacks);
+
+    vector<int> x(MAX_SLOTS), y(MAX_SLOTS), w(MAX_SLOTS), h(MAX_SLOTS);
+    vector<int> clb_out(MAX_SLOTS), bram_out(MAX_SLOTS), dsp_out(MAX_SLOTS);
+    vector<hw_task_allocation> alloc(MAX_SLOTS);
+    auto from_solver = std::make_shared<param_from_solver>(
+        0, 0, &x, &y, &w, &h, &clb_out, &bram_out, &dsp_out, &alloc);
+
+    auto &ctx = solver.context();
+    ctx.weights = point.weights;
+    ctx.preemptive_FRI = point.preemptive_FRI;
+    ctx.formulation = point.formulation;
+    ctx.wirelength_bound = wirelength_bound;
+
+    const auto start = std::chrono::steady_clock::now();
+    solver.start_optimizer(from_solver, param);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    DseResult result;
+    result.point = point;
+    result.status = ctx.status;
+    result.objective = ctx.objective;
+    result.wasted_clb = ctx.wasted_clb_pynq;
+    result.wasted_bram = ctx.wasted_bram_pynq;
+    result.wasted_dsp = ctx.wasted_dsp_pynq;
+    result.wirelength = ctx.wirelength;
+    result.seconds = elapsed.count();
+    if (ctx.status == GRB_OPTIMAL) {
+        result.partitions = from_solver->num_partition;
+        for (int i = 0; i < result.partitions; i++) {
+            result.slots.push_back({x[i], y[i], w[i], h[i]});
+        }
+    }
+    return result;
+}
+
+auto floorplan_dse::append(const DseResult &result) -> void {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_out.is_open()) {
+        m_out << format_line(result) << '\n';
+        m_out.flush();
+    }
+}
+
+} // namespace seu
@@ -0,0 +1,198 @@
+#include "solver/interference.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace seu {
+
+interference_analysis::interference_analysis(const Taskset &t,
+                                             const Platform &platform,
+                                             InterferenceModel model)
+    : m_model(model), m_hw(t.maxHW_Tasks), m_sw(t.maxSW_Tasks),
+      m_res(platform.N_FPGA_RESOURCES), m_partitions(t.maxPartitions) {
+    m_wcet.resize(m_hw);
+    m_demand.resize(m_hw * m_res);
+    m_sw_of.resize(m_hw);
+    for (std::size_t a = 0; a < m_hw; ++a) {
+        const auto &task = t.HW_Tasks[a];
+        m_wcet[a] = task.WCET;
+        m_sw_of[a] = static_cast<int>(task.SW_Task_ID);
+        for (std::size_t x = 0; x < m_res; ++x) {
+            m_demand[a * m_res + x] = task.resDemand[x];
+        }
+    }
+    m_rec_per_unit.assign(platform.recTimePerUnit.begin(),
+                          platform.recTimePerUnit.end());
+    m_hw_offsets.assign(m_sw + 1, 0);
+    for (std::size_t i = 0; i < m_sw; ++i) {
+        for (auto a : t.SW_Tasks[i].H) {
+            if (a >= m_hw) {
+                throw std::runtime_error(
+                    "SW task references unknown HW task in interference");
+            }
+            m_hw_rows.push_back(static_cast<int>(a));
+        }
+        m_hw_offsets[i + 1] = static_cast<int>(m_hw_rows.size());
+    }
+}
+
+auto interference_analysis::from_matrix(const std::vector<std::vector<int>> &A)
+    -> std::vector<int> {
+    std::vector<int> partition_of(A.size(), -1);
+    for (std::size_t a = 0; a < A.size(); ++a) {
+        for (std::size_t k = 0; k < A[a].size(); ++k) {
+            if (A[a][k] == 0) {
+                continue;
+            }
+            if (partition_of[a] >= 0) {
+                throw std::runtime_error(
+                    "HW task allocated to more than one partition");
+            }
+            partition_of[a] = static_cast<int>(k);
+        }
+        if (partition_of[a] < 0) {
+            throw std::runtime_error("HW task not allocated to any partition");
+        }
+    }
+    return partition_of;
+}
+
+// 分区的资源、重配置时间，以及每个分区之外最大的 r：记录 r 最大、次大的两个
+// 分区，O(n + partitions * res)
+auto interference_analysis::prepare(const std::vector<int> &partition_of)
+    -> void {
+    if (partition_of.size() != m_hw) {
+        throw std::runtime_error("Allocation size mismatch in interference");
+    }
+    for (auto k : partition_of) {
+        if (k < 0 || static_cast<std::size_t>(k) >= m_partitions) {
+            throw std::runtime_error("Partition out of range in interference");
+        }
+    }
+    m_part = partition_of.data();
+    m_count.assign(m_partitions, 0);
+    m_size.assign(m_partitions * m_res, 0.0);
+    for (std::size_t a = 0; a < m_hw; ++a) {
+        const std::size_t k = m_part[a];
+        m_count[k]++;
+        for (std::size_t x = 0; x < m_res; ++x) {
+            m_size[k * m_res + x] =
+                std::max(m_size[k * m_res + x], m_demand[a * m_res + x]);
+        }
+    }
+    m_rec.assign(m_partitions, 0.0);
+    int first = -1, second = -1;
+    for (std::size_t k = 0; k < m_partitions; ++k) {
+        if (m_count[k] < 2 || m_model == InterferenceModel::AS_BUILT) {
+            continue;
+        }
+        for (std::size_t x = 0; x < m_res; ++x) {
+            m_rec[k] += m_rec_per_unit[x] * m_size[k * m_res + x];
+        }
+        if (first < 0 || m_rec[k] > m_rec[first]) {
+            second = first;
+            first = static_cast<int>(k);
+        } else if (second < 0 || m_rec[k] > m_rec[second]) {
+            second = static_cast<int>(k);
+        }
+    }
+    m_np.assign(m_partitions, 0.0);
+    for (std::size_t k = 0; k < m_partitions; ++k) {
+        const int other = static_cast<int>(k) == first ? second : first;
+        m_np[k] = other >= 0 ? m_rec[other] : 0.0;
+    }
+    m_r.resize(m_hw);
+    for (std::size_t a = 0; a < m_hw; ++a) {
+        m_r[a] = m_rec[m_part[a]];
+    }
+}
+
+// 第 i 个 SW 任务的响应时间；对其每个需要重配置的 HW 任务 a 遍历其他 SW 任务
+// 的 HW 任务，整体 O(n^2)
+auto interference_analysis::response(std::size_t i, bool preemptive_FRI,
+                                     InterferenceResult *out) const
+    -> double {
+    double total = 0.0;
+    for (int e = m_hw_offsets[i]; e < m_hw_offsets[i + 1]; ++e) {
+        const int a = m_hw_rows[e];
+        const int k = m_part[a];
+        total += m_r[a] + m_wcet[a];
+        if (m_count[k] < 2) {
+            continue;
+        }
+        if (!preemptive_FRI) {
+            total += m_count[k] * m_np[k];
+        }
+        for (std::size_t j = 0; j < m_sw; ++j) {
+            if (j == i || static_cast<int>(j) == m_sw_of[a]) {
+                continue;
+            }
+            double worst = 0.0;
+            for (int f = m_hw_offsets[j]; f < m_hw_offsets[j + 1]; ++f) {
+                const int b = m_hw_rows[f];
+                const double slot =
+                    (b != a && m_part[b] == k) ? m_wcet[b] : 0.0;
+                worst = std::max(worst, slot + m_r[b]);
+            }
+            total += worst;
+            if (out) {
+                out->delta[a * m_sw + j] = worst;
+            }
+        }
+    }
+    return total;
+}
+
+auto interference_analysis::evaluate(const std::vector<int> &partition_of,
+                                     const std::vector<double> &slacks,
+                                     bool preemptive_FRI)
+    -> InterferenceResult {
+    prepare(partition_of);
+    InterferenceResult result;
+    result.hw_tasks = m_hw;
+    result.sw_tasks = m_sw;
+    result.gamma.resize(m_hw);
+    result.rec_time = m_r;
+    result.i_slot.assign(m_hw * m_hw, 0.0);
+    result.delta.assign(m_hw * m_sw, 0.0);
+    if (!preemptive_FRI) {
+        result.delta_np.assign(m_hw * m_hw, 0.0);
+    }
+    for (std::size_t a = 0; a < m_hw; ++a) {
+        const int k = m_part[a];
+        result.gamma[a] = m_count[k] > 1;
+        for (std::size_t b = 0; b < m_hw; ++b) {
+            if (m_part[b] != k) {
+                continue;
+            }
+            if (b != a) {
+                result.i_slot[a * m_hw + b] = m_wcet[b];
+            }
+            if (!preemptive_FRI && result.gamma[a]) {
+                result.delta_np[a * m_hw + b] = m_np[k];
+            }
+        }
+    }
+    result.response.resize(m_sw);
+    result.slack_left.resize(m_sw);
+    result.feasible = true;
+    for (std::size_t i = 0; i < m_sw; ++i) {
+        result.response[i] = response(i, preemptive_FRI, &result);
+        result.slack_left[i] = slacks.at(i) - result.response[i];
+        result.feasible = result.feasible && result.slack_left[i] >= 0.0;
+    }
+    return result;
+}
+
+auto interference_analysis::feasible(const std::vector<int> &partition_of,
+                                     const std::vector<double> &slacks,
+                                     bool preemptive_FRI) -> bool {
+    prepare(partition_of);
+    for (std::size_t i = 0; i < m_sw; ++i) {
+        if (response(i, preemptive_FRI, nullptr) > slacks.at(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace seu
@@ -0,0 +1,271 @@
+#include "solver/kmeans_hamerly.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace seu {
+
+auto relax_hamerly_bounds(const std::vector<double> &moved,
+                          const std::vector<int> &assignments,
+                          std::vector<double> &upper,
+                          std::vector<double> &lower) -> void {
+    const size_t k = moved.size();
+    if (k == 0) {
+        return;
+    }
+    // 最大和次大的移动距离
+    size_t far = 0;
+    for (size_t j = 1; j < k; ++j) {
+        if (moved[j] > moved[far]) {
+            far = j;
+        }
+    }
+    double second_far = 0.0;
+    for (size_t j = 0; j < k; ++j) {
+        if (j != far) {
+            second_far = std::max(second_far, moved[j]);
+        }
+    }
+    for (size_t i = 0; i < assignments.size(); ++i) {
+        int a = assignments[i];
+        upper[i] += moved[a];
+        lower[i] -= (static_cast<size_t>(a) == far) ? second_far : moved[far];
+    }
+}
+
+auto kmeans_hamerly::load_centroids(const std::vector<Centroid> &centroids)
+    -> void {
+    size_t k = centroids.size();
+    m_cclb.resize(k);
+    m_cdsp.resize(k);
+    m_cbram.resize(k);
+    for (size_t j = 0; j < k; ++j) {
+        m_cclb[j] = centroids[j].clb;
+        m_cdsp[j] = centroids[j].dsp;
+        m_cbram[j] = centroids[j].bram;
+    }
+}
+
+// 对所有任务计算最近和次近的中心
+// 外层按中心、内层按任务整列扫描，内层循环没有分支，可以被自动向量化
+auto kmeans_hamerly::assign_all(std::vector<int> &assignments) -> void {
+    const size_t n = m_tasks.size();
+    const size_t k = m_cclb.size();
+    const double *x = m_tasks.clb.data();
+    const double *y = m_tasks.dsp.data();
+    const double *z = m_tasks.bram.data();
+    double *best = m_upper.data();
+    double *second = m_lower.data();
+    int *a = assignments.data();
+
+    std::fill(m_upper.begin(), m_upper.end(),
+              std::numeric_limits<double>::max());
+    std::fill(m_lower.begin(), m_lower.end(),
+              std::numeric_limits<double>::max());
+    for (size_t j = 0; j < k; ++j) {
+        const double cx = m_cclb[j];
+        const double cy = m_cdsp[j];
+        const double cz = m_cbram[j];
+        const int cj = static_cast<int>(j);
+        for (size_t i = 0; i < n; ++i) {
+            double dx = x[i] - cx;
+            double dy = y[i] - cy;
+            double dz = z[i] - cz;
+            double d2 = dx * dx + dy * dy + dz * dz;
+            bool closer = d2 < best[i];
+            second[i] = closer ? best[i] : std::min(second[i], d2);
+            best[i] = closer ? d2 : best[i];
+            a[i] = closer ? cj : a[i];
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        m_upper[i] = std::sqrt(m_upper[i]);
+        m_lower[i] = std::sqrt(m_lower[i]);
+    }
+    m_evaluations += static_cast<long>(n * k);
+}
+
+// 单个任务到全部中心的距离，按中心方向向量化
+auto kmeans_hamerly::assign_one(size_t i, int &best) -> void {
+    const size_t k = m_cclb.size();
+    const double px = m_tasks.clb[i];
+    const double py = m_tasks.dsp[i];
+    const double pz = m_tasks.bram[i];
+    double *d2 = m_dist2.data();
+    for (size_t j = 0; j < k; ++j) {
+        double dx = px - m_cclb[j];
+        double dy = py - m_cdsp[j];
+        double dz = pz - m_cbram[j];
+        d2[j] = dx * dx + dy * dy + dz * dz;
+    }
+
+    double d1 = std::numeric_limits<double>::max();
+    double dsecond = std::numeric_limits<double>::max();
+    int idx = 0;
+    for (size_t j = 0; j < k; ++j) {
+        if (d2[j] < d1) {
+            dsecond = d1;
+            d1 = d2[j];
+            idx = static_cast<int>(j);
+        } else if (d2[j] < dsecond) {
+            dsecond = d2[j];
+        }
+    }
+    best = idx;
+    m_upper[i] = std::sqrt(d1);
+    m_lower[i] = std::sqrt(dsecond);
+    m_evaluations += static_cast<long>(k);
+}
+
+// 按当前分配重新累加每个类的资源和
+auto kmeans_hamerly::accumulate(const std::vector<int> &assignments) -> void {
+    const size_t k = m_cclb.size();
+    m_sx.assign(k, 0.0);
+    m_sy.assign(k, 0.0);
+    m_sz.assign(k, 0.0);
+    m_count.assign(k, 0);
+    for (size_t i = 0; i < m_tasks.size(); ++i) {
+        int c = assignments[i];
+        m_sx[c] += m_tasks.clb[i];
+        m_sy[c] += m_tasks.dsp[i];
+        m_sz[c] += m_tasks.bram[i];
+        m_count[c]++;
+    }
+}
+
+auto kmeans_hamerly::move_task(size_t i, int from, int to) -> void {
+    m_sx[from] -= m_tasks.clb[i];
+    m_sy[from] -= m_tasks.dsp[i];
+    m_sz[from] -= m_tasks.bram[i];
+    m_count[from]--;
+    m_sx[to] += m_tasks.clb[i];
+    m_sy[to] += m_tasks.dsp[i];
+    m_sz[to] += m_tasks.bram[i];
+    m_count[to]++;
+}
+
+// 重新计算中心，记录每个中心的移动距离，返回最大移动距离；增量模式下
+// 资源和已随任务的移动更新
+auto kmeans_hamerly::update_centroids(const std::vector<int> &assignments)
+    -> double {
+    const size_t k = m_cclb.size();
+    if (!m_incremental) {
+        accumulate(assignments);
+    }
+
+    double max_moved = 0.0;
+    for (size_t j = 0; j < k; ++j) {
+        m_moved[j] = 0.0;
+        // 空类保持原来的聚类中心
+        if (m_count[j] == 0) {
+            continue;
+        }
+        double nx = m_sx[j] / m_count[j];
+        double ny = m_sy[j] / m_count[j];
+        double nz = m_sz[j] / m_count[j];
+        double dx = nx - m_cclb[j];
+        double dy = ny - m_cdsp[j];
+        double dz = nz - m_cbram[j];
+        m_moved[j] = std::sqrt(dx * dx + dy * dy + dz * dz);
+        max_moved = std::max(max_moved, m_moved[j]);
+        m_cclb[j] = nx;
+        m_cdsp[j] = ny;
+        m_cbram[j] = nz;
+    }
+    return max_moved;
+}
+
+auto kmeans_hamerly::update_half_separation() -> void {
+    const size_t k = m_cclb.size();
+    std::fill(m_half.begin(), m_half.end(), std::numeric_limits<double>::max());
+    for (size_t j = 0; j < k; ++j) {
+        for (size_t jj = j + 1; jj < k; ++jj) {
+            double dx = m_cclb[j] - m_cclb[jj];
+            double dy = m_cdsp[j] - m_cdsp[jj];
+            double dz = m_cbram[j] - m_cbram[jj];
+            double d = 0.5 * std::sqrt(dx * dx + dy * dy + dz * dz);
+            m_half[j] = std::min(m_half[j], d);
+            m_half[jj] = std::min(m_half[jj], d);
+        }
+    }
+}
+
+auto kmeans_hamerly::run(std::vector<Centroid> &centroids,
+                         std::vector<int> &assignments, double tolerance,
+                         int max_iterations) -> int {
+    const size_t n = m_tasks.size();
+    const size_t k = centroids.size();
+    m_evaluations = 0;
+    m_moved_tasks = 0;
+    assignments.assign(n, 0);
+    if (n == 0 || k == 0) {
+        return 0;
+    }
+
+    load_centroids(centroids);
+    m_upper.resize(n);
+    m_lower.resize(n);
+    m_half.resize(k);
+    m_moved.resize(k);
+    m_dist2.resize(k);
+
+    assign_all(assignments);
+    if (m_incremental) {
+        accumulate(assignments);
+    }
+
+    int iteration = 0;
+    bool stale = false; // 分配已改变但中心尚未重新计算
+    while (iteration < max_iterations) {
+        iteration++;
+        double max_moved = update_centroids(assignments);
+        relax_hamerly_bounds(m_moved, assignments, m_upper, m_lower);
+
+        if (max_moved <= tolerance) {
+            break;
+        }
+
+        update_half_separation();
+        bool changed = false;
+        for (size_t i = 0; i < n; ++i) {
+            int a = assignments[i];
+            double bound = std::max(m_half[a], m_lower[i]);
+            if (m_upper[i] <= bound) {
+                continue;
+            }
+            // 先收紧上界，仍不满足时才计算到全部中心的距离
+            double dx = m_tasks.clb[i] - m_cclb[a];
+            double dy = m_tasks.dsp[i] - m_cdsp[a];
+            double dz = m_tasks.bram[i] - m_cbram[a];
+            m_upper[i] = std::sqrt(dx * dx + dy * dy + dz * dz);
+            m_evaluations++;
+            if (m_upper[i] <= bound) {
+                continue;
+            }
+            int best = a;
+            assign_one(i, best);
+            if (best != a) {
+                if (m_incremental) {
+                    move_task(i, a, best);
+                }
+                assignments[i] = best;
+                m_moved_tasks++;
+                changed = true;
+            }
+        }
+        stale = changed;
+        if (!changed) {
+            break;
+        }
+    }
+    if (stale) {
+        update_centroids(assignments);
+    }
+
+    for (size_t j = 0; j < k; ++j) {
+        centroids[j] = {m_cclb[j], m_cdsp[j], m_cbram[j]};
+    }
+    return iteration;
+}
+
+} // namespace seu
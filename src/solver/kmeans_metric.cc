@@ -0,0 +1,269 @@
+#include "solver/kmeans_metric.h"
+#include "rng.h"
+#include "solver/kmeans_hamerly.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace seu {
+
+template <typename Metric>
+kmeans_metric<Metric>::kmeans_metric(const TaskTable &tasks,
+                                     const Metric &metric)
+    : m_tasks(tasks), m_metric(metric) {
+    const size_t n = tasks.size();
+    m_projected.clb.resize(n);
+    m_projected.dsp.resize(n);
+    m_projected.bram.resize(n);
+    auto clb = tasks.clb();
+    auto dsp = tasks.dsp();
+    auto bram = tasks.bram();
+    for (size_t row = 0; row < n; ++row) {
+        m_projected.clb[row] = m_metric.task(clb[row], 0);
+        m_projected.dsp[row] = m_metric.task(dsp[row], 1);
+        m_projected.bram[row] = m_metric.task(bram[row], 2);
+    }
+}
+
+template <typename Metric>
+auto kmeans_metric<Metric>::distance(size_t row, const Centroid &c) const
+    -> double {
+    return Metric::combine(m_projected.clb[row] - m_metric.center(c.clb, 0),
+                           m_projected.dsp[row] - m_metric.center(c.dsp, 1),
+                           m_projected.bram[row] - m_metric.center(c.bram, 2));
+}
+
+template <typename Metric>
+auto kmeans_metric<Metric>::project_centers(
+    const std::vector<Centroid> &centroids) -> void {
+    m_centers.resize(centroids.size());
+    for (size_t j = 0; j < centroids.size(); ++j) {
+        m_centers[j] = {m_metric.center(centroids[j].clb, 0),
+                        m_metric.center(centroids[j].dsp, 1),
+                        m_metric.center(centroids[j].bram, 2)};
+    }
+}
+
+template <typename Metric>
+auto kmeans_metric<Metric>::center_distance(size_t row, size_t j) const
+    -> double {
+    const auto &c = m_centers[j];
+    return std::sqrt(Metric::combine(m_projected.clb[row] - c.clb,
+                                     m_projected.dsp[row] - c.dsp,
+                                     m_projected.bram[row] - c.bram));
+}
+
+// 外层按中心、内层按任务，combine 内联后内层循环没有分支，可以被自动向量化；
+// 同时求出最近和次近的距离，作为 Hamerly 上下界的初值
+template <typename Metric>
+auto kmeans_metric<Metric>::assign_all(std::vector<int> &nearest) -> void {
+    const size_t n = m_projected.size();
+    const double *x = m_projected.clb.data();
+    const double *y = m_projected.dsp.data();
+    const double *z = m_projected.bram.data();
+    m_upper.assign(n, std::numeric_limits<double>::max());
+    m_lower.assign(n, std::numeric_limits<double>::max());
+    nearest.assign(n, 0);
+    double *best = m_upper.data();
+    double *second = m_lower.data();
+    int *a = nearest.data();
+    for (size_t j = 0; j < m_centers.size(); ++j) {
+        const double cx = m_centers[j].clb;
+        const double cy = m_centers[j].dsp;
+        const double cz = m_centers[j].bram;
+        const int cj = static_cast<int>(j);
+        for (size_t i = 0; i < n; ++i) {
+            double d = Metric::combine(x[i] - cx, y[i] - cy, z[i] - cz);
+            bool closer = d < best[i];
+            second[i] = closer ? best[i] : std::min(second[i], d);
+            best[i] = closer ? d : best[i];
+            a[i] = closer ? cj : a[i];
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        m_upper[i] = std::sqrt(m_upper[i]);
+        m_lower[i] = std::sqrt(m_lower[i]);
+    }
+    m_evaluations += static_cast<long>(n * m_centers.size());
+}
+
+// 单个任务到全部中心的距离，更新上下界，返回最近的中心
+template <typename Metric>
+auto kmeans_metric<Metric>::assign_one(size_t row) -> int {
+    double d1 = std::numeric_limits<double>::max();
+    double d2 = std::numeric_limits<double>::max();
+    int best = 0;
+    for (size_t j = 0; j < m_centers.size(); ++j) {
+        double d = center_distance(row, j);
+        if (d < d1) {
+            d2 = d1;
+            d1 = d;
+            best = static_cast<int>(j);
+        } else if (d < d2) {
+            d2 = d;
+        }
+    }
+    m_upper[row] = d1;
+    m_lower[row] = d2;
+    m_evaluations += static_cast<long>(m_centers.size());
+    return best;
+}
+
+// 变换后的中心移动后，记录移动距离与每个中心到最近其他中心距离的一半
+template <typename Metric>
+auto kmeans_metric<Metric>::update_separation(
+    const std::vector<Centroid> &previous) -> void {
+    auto between = [](const Centroid &p, const Centroid &q) {
+        return std::sqrt(Metric::combine(p.clb - q.clb, p.dsp - q.dsp,
+                                         p.bram - q.bram));
+    };
+    const size_t k = m_centers.size();
+    m_moved.resize(k);
+    m_half.assign(k, std::numeric_limits<double>::max());
+    for (size_t j = 0; j < k; ++j) {
+        m_moved[j] = between(m_centers[j], previous[j]);
+        for (size_t jj = j + 1; jj < k; ++jj) {
+            double d = 0.5 * between(m_centers[j], m_centers[jj]);
+            m_half[j] = std::min(m_half[j], d);
+            m_half[jj] = std::min(m_half[jj], d);
+        }
+    }
+}
+
+template <typename Metric>
+auto kmeans_metric<Metric>::seed(int k, std::uint64_t seed)
+    -> std::vector<Centroid> {
+    const size_t n = m_tasks.size();
+    auto clb = m_tasks.clb();
+    auto dsp = m_tasks.dsp();
+    auto bram = m_tasks.bram();
+    auto at = [&](size_t row) {
+        return Centroid{static_cast<double>(clb[row]),
+                        static_cast<double>(dsp[row]),
+                        static_cast<double>(bram[row])};
+    };
+
+    std::vector<Centroid> centroids;
+    centroids.reserve(k);
+    Rng rng(seed);
+    centroids.push_back(at(rng() % n));
+
+    std::vector<double> min_d2(n, std::numeric_limits<double>::max());
+    while (static_cast<int>(centroids.size()) < k) {
+        double sum = 0.0;
+        for (size_t row = 0; row < n; ++row) {
+            min_d2[row] =
+                std::min(min_d2[row], distance(row, centroids.back()));
+            sum += min_d2[row];
+        }
+        size_t chosen = 0;
+        if (sum > 0.0) {
+            double target = rng.uniform01() * sum;
+            double acc = 0.0;
+            for (chosen = 0; chosen + 1 < n; ++chosen) {
+                acc += min_d2[chosen];
+                if (acc > target) {
+                    break;
+                }
+            }
+        } else {
+            chosen = rng() % n;
+        }
+        centroids.push_back(at(chosen));
+    }
+    return centroids;
+}
+
+template <typename Metric>
+auto kmeans_metric<Metric>::run(std::vector<Centroid> &centroids,
+                                std::vector<int> &assignments,
+                                const ClusterOptions &options) -> ClusterStats {
+    const size_t n = m_tasks.size();
+    const size_t k = centroids.size();
+    if (n == 0) {
+        throw std::runtime_error("Empty task table in kmeans_metric");
+    }
+    ClusterStats stats;
+    if (k == 0) {
+        assignments.clear();
+        return stats;
+    }
+    if (options.seeding != SeedMode::PROVIDED) {
+        centroids = seed(static_cast<int>(k), options.seed);
+    }
+
+    auto clb = m_tasks.clb();
+    auto dsp = m_tasks.dsp();
+    auto bram = m_tasks.bram();
+    std::vector<Centroid> sums(k);
+    std::vector<long> count(k, 0);
+    auto add = [&](size_t row, int c, double sign) {
+        sums[c].clb += sign * clb[row];
+        sums[c].dsp += sign * dsp[row];
+        sums[c].bram += sign * bram[row];
+        count[c] += static_cast<long>(sign);
+    };
+    // 空类保持原来的聚类中心
+    auto update = [&]() {
+        for (size_t j = 0; j < k; ++j) {
+            if (count[j] > 0) {
+                centroids[j] = {sums[j].clb / count[j], sums[j].dsp / count[j],
+                                sums[j].bram / count[j]};
+            }
+        }
+    };
+
+    m_evaluations = 0;
+    project_centers(centroids);
+    assign_all(assignments);
+    for (size_t row = 0; row < n; ++row) {
+        add(row, assignments[row], 1.0);
+    }
+
+    // 每轮先按中心的移动放松上下界，上界严格小于下界或中心间距的一半时
+    // 任务不可能改变归属，跳过距离计算
+    std::vector<Centroid> previous;
+    while (stats.iterations < options.max_iterations) {
+        stats.iterations++;
+        update();
+        previous = m_centers;
+        project_centers(centroids);
+        update_separation(previous);
+        relax_hamerly_bounds(m_moved, assignments, m_upper, m_lower);
+        long moved = 0;
+        for (size_t row = 0; row < n; ++row) {
+            const int a = assignments[row];
+            const double bound = std::max(m_half[a], m_lower[row]);
+            if (m_upper[row] < bound) {
+                continue;
+            }
+            m_upper[row] = center_distance(row, a);
+            m_evaluations++;
+            if (m_upper[row] < bound) {
+                continue;
+            }
+            const int c = assign_one(row);
+            if (c != a) {
+                add(row, a, -1.0);
+                add(row, c, 1.0);
+                assignments[row] = c;
+                moved++;
+            }
+        }
+        stats.moved_tasks += moved;
+        if (moved == 0) {
+            break;
+        }
+    }
+    update();
+    stats.distance_evaluations = m_evaluations;
+    return stats;
+}
+
+template class kmeans_metric<EuclideanMetric>;
+template class kmeans_metric<WeightedMetric>;
+template class kmeans_metric<NormalizedMetric>;
+template class kmeans_metric<ChebyshevMetric>;
+template class kmeans_metric<TileMetric>;
+
+} // namespace seu
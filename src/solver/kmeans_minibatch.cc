@@ -0,0 +1,162 @@
+#include "solver/kmeans_minibatch.h"
+#include "solver/kmeans_parallel.h"
+#include "solver/packed_tasks.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace seu {
+
+namespace {
+
+auto pack(const TaskBatch &batch, PackedTasks &packed) -> void {
+    packed.clb.assign(batch.clb.begin(), batch.clb.end());
+    packed.dsp.assign(batch.dsp.begin(), batch.dsp.end());
+    packed.bram.assign(batch.bram.begin(), batch.bram.end());
+}
+
+// 批内每个任务最近的中心；外层按中心、内层按任务，内层无分支便于向量化
+auto assign(const PackedTasks &packed, const std::vector<Centroid> &centroids,
+            std::vector<double> &best, std::vector<int> &nearest) -> void {
+    const size_t n = packed.size();
+    best.assign(n, std::numeric_limits<double>::max());
+    nearest.assign(n, 0);
+    for (size_t j = 0; j < centroids.size(); ++j) {
+        const double cx = centroids[j].clb;
+        const double cy = centroids[j].dsp;
+        const double cz = centroids[j].bram;
+        const int cj = static_cast<int>(j);
+        for (size_t i = 0; i < n; ++i) {
+            double dx = packed.clb[i] - cx;
+            double dy = packed.dsp[i] - cy;
+            double dz = packed.bram[i] - cz;
+            double d2 = dx * dx + dy * dy + dz * dz;
+            bool closer = d2 < best[i];
+            best[i] = closer ? d2 : best[i];
+            nearest[i] = closer ? cj : nearest[i];
+        }
+    }
+}
+
+// 在一批任务上选初始中心
+auto seed(const TaskBatch &batch, int k, const ClusterOptions &options)
+    -> std::vector<Centroid> {
+    if (options.seeding == SeedMode::KMEANS_PARALLEL) {
+        PackedTasks packed;
+        pack(batch, packed);
+        return kmeans_parallel::seed(packed, k, options);
+    }
+    // 流中的 id 可能重复，这里用行号作为 id
+    TaskTable sample;
+    sample.reserve(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        sample.push_back(static_cast<int>(i), batch.clb[i], batch.dsp[i],
+                         batch.bram[i], batch.exec[i]);
+    }
+    std::vector<Centroid> centroids;
+    kmeanspp::initCentroidsKMeansPlusPlus(sample, centroids, k, options.seed);
+    return centroids;
+}
+
+} // namespace
+
+auto kmeans_minibatch::cluster(TaskStream &stream,
+                               std::vector<Centroid> &centroids,
+                               const ClusterOptions &options) -> ClusterStats {
+    const size_t k = centroids.size();
+    ClusterStats stats;
+    if (k == 0) {
+        return stats;
+    }
+    const size_t batch_size = std::max<size_t>(options.batch_size, 1);
+
+    TaskBatch batch;
+    if (options.seeding != SeedMode::PROVIDED) {
+        stream.reset();
+        if (stream.next_batch(std::max(batch_size, k), batch) == 0) {
+            throw std::runtime_error("Empty task stream in kmeans_minibatch");
+        }
+        centroids = seed(batch, static_cast<int>(k), options);
+    }
+
+    PackedTasks packed;
+    std::vector<double> best;
+    std::vector<int> nearest;
+    std::vector<double> total(k, 0.0); // v[j]
+    std::vector<Centroid> sums(k);
+    std::vector<double> count(k);
+    std::vector<Centroid> epoch_start;
+    for (int epoch = 0; epoch < options.epochs; ++epoch) {
+        epoch_start = centroids;
+        stream.reset();
+        while (stream.next_batch(batch_size, batch) > 0) {
+            pack(batch, packed);
+            assign(packed, centroids, best, nearest);
+
+            std::fill(sums.begin(), sums.end(), Centroid{});
+            std::fill(count.begin(), count.end(), 0.0);
+            for (size_t i = 0; i < packed.size(); ++i) {
+                auto &sum = sums[nearest[i]];
+                sum.clb += packed.clb[i];
+                sum.dsp += packed.dsp[i];
+                sum.bram += packed.bram[i];
+                count[nearest[i]] += 1.0;
+            }
+            // 等价于对本批任务逐个做 c += (x - c) / v[j]
+            for (size_t j = 0; j < k; ++j) {
+                if (count[j] == 0.0) {
+                    continue;
+                }
+                total[j] += count[j];
+                double eta = 1.0 / total[j];
+                auto &c = centroids[j];
+                c.clb += eta * (sums[j].clb - count[j] * c.clb);
+                c.dsp += eta * (sums[j].dsp - count[j] * c.dsp);
+                c.bram += eta * (sums[j].bram - count[j] * c.bram);
+            }
+            stats.iterations++;
+        }
+
+        double max_moved = 0.0;
+        for (size_t j = 0; j < k; ++j) {
+            double dx = centroids[j].clb - epoch_start[j].clb;
+            double dy = centroids[j].dsp - epoch_start[j].dsp;
+            double dz = centroids[j].bram - epoch_start[j].bram;
+            max_moved =
+                std::max(max_moved, std::sqrt(dx * dx + dy * dy + dz * dz));
+        }
+        if (max_moved <= options.tolerance) {
+            break;
+        }
+    }
+    return stats;
+}
+
+auto kmeans_minibatch::max_resources(TaskStream &stream,
+                                     const std::vector<Centroid> &centroids,
+                                     std::size_t batch_size)
+    -> std::vector<std::tuple<int, int, int>> {
+    std::vector<std::tuple<int, int, int>> res(centroids.size(), {0, 0, 0});
+    if (centroids.empty()) {
+        return res;
+    }
+    TaskBatch batch;
+    PackedTasks packed;
+    std::vector<double> best;
+    std::vector<int> nearest;
+    stream.reset();
+    while (stream.next_batch(std::max<size_t>(batch_size, 1), batch) > 0) {
+        pack(batch, packed);
+        assign(packed, centroids, best, nearest);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            auto &[c, d, b] = res[nearest[i]];
+            c = std::max(c, batch.clb[i]);
+            d = std::max(d, batch.dsp[i]);
+            b = std::max(b, batch.bram[i]);
+        }
+    }
+    return res;
+}
+
+} // namespace seu
@@ -0,0 +1,233 @@
+#include "solver/kmeans_parallel.h"
+#include "rng.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace seu {
+
+namespace {
+
+constexpr size_t CHUNK_SIZE = 4096;
+constexpr int RECLUSTER_ITERATIONS = 10;
+
+auto num_chunks(size_t n) -> size_t { return (n + CHUNK_SIZE - 1) / CHUNK_SIZE; }
+
+// 有线程池时并行执行，否则按块顺序执行；两种方式的块划分相同
+auto for_chunks(ThreadPool *pool, size_t n,
+                const std::function<void(size_t, size_t, size_t)> &fn)
+    -> void {
+    if (pool != nullptr) {
+        pool->parallel_for(0, n, CHUNK_SIZE, fn);
+        return;
+    }
+    for (size_t c = 0; c < num_chunks(n); ++c) {
+        fn(c * CHUNK_SIZE, std::min(n, (c + 1) * CHUNK_SIZE), c);
+    }
+}
+
+auto dist2(const Centroid &a, const Centroid &b) -> double {
+    double dx = a.clb - b.clb;
+    double dy = a.dsp - b.dsp;
+    double dz = a.bram - b.bram;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+// 在加权候选集上做 K-Means++ 初始化和若干轮加权 Lloyd 迭代
+auto recluster(const std::vector<Centroid> &candidates,
+               const std::vector<double> &weights, int k, Rng &rng)
+    -> std::vector<Centroid> {
+    const size_t m = candidates.size();
+    std::vector<Centroid> centers;
+    centers.reserve(k);
+
+    double total_weight = std::accumulate(weights.begin(), weights.end(), 0.0);
+    double pick = rng.uniform01() * total_weight;
+    size_t first = 0;
+    for (double acc = 0.0; first + 1 < m; ++first) {
+        acc += weights[first];
+        if (acc > pick) {
+            break;
+        }
+    }
+    centers.push_back(candidates[first]);
+
+    std::vector<double> min_d2(m, std::numeric_limits<double>::max());
+    while (static_cast<int>(centers.size()) < k) {
+        double sum = 0.0;
+        for (size_t i = 0; i < m; ++i) {
+            min_d2[i] = std::min(min_d2[i], dist2(candidates[i], centers.back()));
+            sum += weights[i] * min_d2[i];
+        }
+        size_t chosen = 0;
+        if (sum > 0.0) {
+            double target = rng.uniform01() * sum;
+            double acc = 0.0;
+            for (chosen = 0; chosen + 1 < m; ++chosen) {
+                acc += weights[chosen] * min_d2[chosen];
+                if (acc > target) {
+                    break;
+                }
+            }
+        } else {
+            chosen = rng() % m;
+        }
+        centers.push_back(candidates[chosen]);
+    }
+
+    std::vector<Centroid> sums(k);
+    std::vector<double> mass(k);
+    for (int it = 0; it < RECLUSTER_ITERATIONS; ++it) {
+        std::fill(sums.begin(), sums.end(), Centroid{});
+        std::fill(mass.begin(), mass.end(), 0.0);
+        for (size_t i = 0; i < m; ++i) {
+            int best = 0;
+            double best_d2 = dist2(candidates[i], centers[0]);
+            for (int j = 1; j < k; ++j) {
+                double d2 = dist2(candidates[i], centers[j]);
+                if (d2 < best_d2) {
+                    best_d2 = d2;
+                    best = j;
+                }
+            }
+            sums[best].clb += weights[i] * candidates[i].clb;
+            sums[best].dsp += weights[i] * candidates[i].dsp;
+            sums[best].bram += weights[i] * candidates[i].bram;
+            mass[best] += weights[i];
+        }
+        for (int j = 0; j < k; ++j) {
+            if (mass[j] > 0.0) {
+                centers[j] = {sums[j].clb / mass[j], sums[j].dsp / mass[j],
+                              sums[j].bram / mass[j]};
+            }
+        }
+    }
+    return centers;
+}
+
+} // namespace
+
+auto kmeans_parallel::seed(const PackedTasks &tasks, int k,
+                           const ClusterOptions &options)
+    -> std::vector<Centroid> {
+    const size_t n = tasks.size();
+    if (n == 0) {
+        throw std::runtime_error("Empty task set in kmeans_parallel::seed");
+    }
+    if (k <= 0) {
+        return {};
+    }
+
+    auto point = [&](size_t i) {
+        return Centroid{tasks.clb[i], tasks.dsp[i], tasks.bram[i]};
+    };
+
+    Rng rng(options.seed);
+    std::vector<Centroid> candidates;
+    candidates.push_back(point(rng() % n));
+
+    // 最近距离数组与最近候选编号，跨轮复用
+    std::vector<double> min_d2(n, std::numeric_limits<double>::max());
+    std::vector<int> closest(n, 0);
+    std::vector<double> chunk_cost(num_chunks(n));
+
+    // 只用 [from, candidates.size()) 这些新候选更新最近距离，返回总代价
+    auto update = [&](size_t from) {
+        const size_t to = candidates.size();
+        for_chunks(options.pool, n, [&](size_t lo, size_t hi, size_t c) {
+            // 外层按候选、内层按任务扫描，内层无分支便于向量化
+            for (size_t j = from; j < to; ++j) {
+                const double cx = candidates[j].clb;
+                const double cy = candidates[j].dsp;
+                const double cz = candidates[j].bram;
+                const int cj = static_cast<int>(j);
+                for (size_t i = lo; i < hi; ++i) {
+                    double dx = tasks.clb[i] - cx;
+                    double dy = tasks.dsp[i] - cy;
+                    double dz = tasks.bram[i] - cz;
+                    double d2 = dx * dx + dy * dy + dz * dz;
+                    bool closer = d2 < min_d2[i];
+                    min_d2[i] = closer ? d2 : min_d2[i];
+                    closest[i] = closer ? cj : closest[i];
+                }
+            }
+            double cost = 0.0;
+            for (size_t i = lo; i < hi; ++i) {
+                cost += min_d2[i];
+            }
+            chunk_cost[c] = cost;
+        });
+        // 按块顺序求和，保证浮点结果与线程数无关
+        return std::accumulate(chunk_cost.begin(), chunk_cost.end(), 0.0);
+    };
+
+    double cost = update(0);
+    const double ell = options.oversampling * k;
+    std::vector<std::vector<size_t>> picked(num_chunks(n));
+    for (int round = 0; round < options.rounds && cost > 0.0; ++round) {
+        const std::uint64_t round_seed =
+            splitmix64(options.seed ^ splitmix64(round + 1));
+        for_chunks(options.pool, n, [&](size_t lo, size_t hi, size_t c) {
+            Rng chunk_rng = Rng::stream(round_seed, c);
+            picked[c].clear();
+            for (size_t i = lo; i < hi; ++i) {
+                if (chunk_rng.uniform01() * cost < ell * min_d2[i]) {
+                    picked[c].push_back(i);
+                }
+            }
+        });
+
+        size_t from = candidates.size();
+        for (const auto &chunk : picked) {
+            for (auto i : chunk) {
+                candidates.push_back(point(i));
+            }
+        }
+        if (candidates.size() == from) {
+            continue;
+        }
+        cost = update(from);
+    }
+
+    // 候选数不足 k 时（任务很少或高度重复），按 d^2 逐个补足
+    while (static_cast<int>(candidates.size()) < k) {
+        size_t chosen = 0;
+        if (cost > 0.0) {
+            double target = rng.uniform01() * cost;
+            double acc = 0.0;
+            for (chosen = 0; chosen + 1 < n; ++chosen) {
+                acc += min_d2[chosen];
+                if (acc > target) {
+                    break;
+                }
+            }
+        } else {
+            chosen = rng() % n;
+        }
+        size_t from = candidates.size();
+        candidates.push_back(point(chosen));
+        cost = update(from);
+    }
+
+    // 每个候选的权重为以它为最近候选的任务数
+    std::vector<std::vector<double>> chunk_weights(num_chunks(n));
+    for_chunks(options.pool, n, [&](size_t lo, size_t hi, size_t c) {
+        chunk_weights[c].assign(candidates.size(), 0.0);
+        for (size_t i = lo; i < hi; ++i) {
+            chunk_weights[c][closest[i]] += 1.0;
+        }
+    });
+    std::vector<double> weights(candidates.size(), 0.0);
+    for (const auto &w : chunk_weights) {
+        for (size_t j = 0; j < w.size(); ++j) {
+            weights[j] += w[j];
+        }
+    }
+
+    return recluster(candidates, weights, k, rng);
+}
+
+} // namespace seu
@@ -0,0 +1,185 @@
+#include "solver/kmeans_sweep.h"
+#include "rng.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace seu {
+
+namespace {
+
+// 每段连续扫描的 k 的个数，段内依次热启动
+constexpr size_t SWEEP_CHUNK = 4;
+
+// 在 k 的收敛结果上按 d^2 采样一个新中心，得到 k + 1 的初始中心
+auto grow(const TaskTable &tasks, const ClusterResult &result,
+          std::uint64_t seed) -> std::vector<Centroid> {
+    auto clb = tasks.clb();
+    auto dsp = tasks.dsp();
+    auto bram = tasks.bram();
+    std::vector<double> d2(tasks.size());
+    double sum = 0.0;
+    for (size_t row = 0; row < tasks.size(); ++row) {
+        const auto &c = result.centroids[result.assignments[row]];
+        double dx = clb[row] - c.clb;
+        double dy = dsp[row] - c.dsp;
+        double dz = bram[row] - c.bram;
+        d2[row] = dx * dx + dy * dy + dz * dz;
+        sum += d2[row];
+    }
+
+    Rng rng(seed);
+    size_t chosen = 0;
+    if (sum > 0.0) {
+        double target = rng.uniform01() * sum;
+        double acc = 0.0;
+        for (chosen = 0; chosen + 1 < tasks.size(); ++chosen) {
+            acc += d2[chosen];
+            if (acc > target) {
+                break;
+            }
+        }
+    } else {
+        chosen = rng() % tasks.size();
+    }
+
+    auto centroids = result.centroids;
+    centroids.push_back({static_cast<double>(clb[chosen]),
+                         static_cast<double>(dsp[chosen]),
+                         static_cast<double>(bram[chosen])});
+    return centroids;
+}
+
+auto evaluate(const TaskTable &tasks, KSweepPoint &point) -> void {
+    const auto &result = point.result;
+    point.area = 0;
+    for (const auto &[clb, dsp, bram] : kmeanspp::getClusterMaxResourcesNumber(
+             tasks, result.assignments, point.k)) {
+        point.area += clb + dsp + bram;
+    }
+    point.silhouette =
+        kmeans_sweep::silhouette(tasks, result.centroids, result.assignments);
+    point.inertia =
+        kmeanspp::inertia(tasks, result.centroids, result.assignments);
+}
+
+} // namespace
+
+auto kmeans_sweep::silhouette(const TaskTable &tasks,
+                              const std::vector<Centroid> &centroids,
+                              const std::vector<int> &assignments) -> double {
+    const size_t k = centroids.size();
+    if (k < 2 || tasks.empty()) {
+        return 0.0;
+    }
+    auto clb = tasks.clb();
+    auto dsp = tasks.dsp();
+    auto bram = tasks.bram();
+    double sum = 0.0;
+    for (size_t row = 0; row < tasks.size(); ++row) {
+        double own = 0.0;
+        double other = std::numeric_limits<double>::max();
+        for (size_t j = 0; j < k; ++j) {
+            double dx = clb[row] - centroids[j].clb;
+            double dy = dsp[row] - centroids[j].dsp;
+            double dz = bram[row] - centroids[j].bram;
+            double d2 = dx * dx + dy * dy + dz * dz;
+            if (static_cast<int>(j) == assignments[row]) {
+                own = d2;
+            } else {
+                other = std::min(other, d2);
+            }
+        }
+        double a = std::sqrt(own);
+        double b = std::sqrt(other);
+        double m = std::max(a, b);
+        sum += m > 0.0 ? (b - a) / m : 0.0;
+    }
+    return sum / tasks.size();
+}
+
+auto kmeans_sweep::run(const TaskTable &tasks, int kmin, int kmax,
+                       const ClusterOptions &options) -> KSweepResult {
+    if (kmin < 1 || kmax < kmin) {
+        throw std::runtime_error("kmeans_sweep needs 1 <= kmin <= kmax");
+    }
+    if (tasks.empty()) {
+        throw std::runtime_error("Empty task table in kmeans_sweep");
+    }
+
+    KSweepResult sweep;
+    sweep.points.resize(kmax - kmin + 1);
+    auto run_chunk = [&](size_t lo, size_t hi, size_t) {
+        ClusterOptions chunk_options = options;
+        chunk_options.pool = nullptr;
+        for (size_t i = lo; i < hi; ++i) {
+            auto &point = sweep.points[i];
+            point.k = kmin + static_cast<int>(i);
+            auto &result = point.result;
+            result.seed = options.seed + point.k;
+            if (i == lo) {
+                result.centroids.resize(point.k);
+                chunk_options.seeding = options.seeding;
+            } else {
+                result.centroids =
+                    grow(tasks, sweep.points[i - 1].result, result.seed);
+                chunk_options.seeding = SeedMode::PROVIDED;
+            }
+            chunk_options.seed = result.seed;
+            result.stats = kmeanspp::kMeansPlusPlusClustering(
+                tasks, result.centroids, result.assignments, chunk_options);
+            evaluate(tasks, point);
+            result.score = point.area;
+        }
+    };
+
+    const size_t n = sweep.points.size();
+    if (options.pool != nullptr) {
+        options.pool->parallel_for(0, n, SWEEP_CHUNK, run_chunk);
+    } else {
+        for (size_t lo = 0; lo < n; lo += SWEEP_CHUNK) {
+            run_chunk(lo, std::min(n, lo + SWEEP_CHUNK), lo / SWEEP_CHUNK);
+        }
+    }
+
+    // q 在 area 与 silhouette 上都不差于 p，且至少一个更好
+    auto dominates = [](const KSweepPoint &q, const KSweepPoint &p) {
+        bool no_worse = q.area <= p.area && q.silhouette >= p.silhouette;
+        bool better = q.area < p.area || q.silhouette > p.silhouette;
+        return no_worse && better;
+    };
+    for (const auto &p : sweep.points) {
+        bool dominated = false;
+        for (const auto &q : sweep.points) {
+            if (dominates(q, p)) {
+                dominated = true;
+                break;
+            }
+        }
+        if (!dominated) {
+            sweep.front.push_back(p.k);
+        }
+    }
+
+    // 肘部法：k 与 inertia 都归一化到 [0, 1]，取在首尾连线下方最远的点
+    sweep.elbow = kmin;
+    const double first = sweep.points.front().inertia;
+    const double last = sweep.points.back().inertia;
+    if (n > 2 && first > last) {
+        double best_gap = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            double x = static_cast<double>(i) / (n - 1);
+            double y = (sweep.points[i].inertia - last) / (first - last);
+            double gap = (1.0 - x) - y;
+            if (gap > best_gap) {
+                best_gap = gap;
+                sweep.elbow = sweep.points[i].k;
+            }
+        }
+    }
+    return sweep;
+}
+
+} // namespace seu
@@ -1,7 +1,11 @@
 #include "solver/kmeanspp.h"
+#include "rng.h"
+#include "solver/kmeans_hamerly.h"
+#include "solver/kmeans_minibatch.h"
+#include "solver/kmeans_parallel.h"
+#include "thread_pool.h"
 #include <Eigen/Dense>
-#include <cstdlib>
-#include <ctime>
+#include <cmath>
 #include <iostream>
 #include <limits>
 #include <tuple>
@@ -24,41 +28,49 @@ auto kmeanspp::euclideanDistance(const TaskRef &t1, const TaskRef &t2)
 // K-Means++算法初始化聚类中心，选择初始的k个聚类中心
 auto kmeanspp::initCentroidsKMeansPlusPlus(
     const std::unordered_map<int, TaskRef> &m_tasks,
-    std::vector<TaskRef> &centroids, int k) -> void {
+    std::vector<TaskRef> &centroids, int k, std::uint64_t seed) -> void {
+    if (k <= 0) {
+        return;
+    }
+    if (m_tasks.empty()) {
+        throw std::runtime_error(
+            "Empty task map in initCentroidsKMeansPlusPlus");
+    }
     std::vector<int> keys;
     for (const auto &pair : m_tasks) {
+        if (!pair.second) {
+            throw std::runtime_error(
+                "Null task encountered in initCentroidsKMeansPlusPlus");
+        }
         keys.push_back(pair.first);
     }
     // 随机选择第一个聚类中心
-    std::srand(static_cast<unsigned int>(std::time(nullptr)));
-    int first_index = std::rand() % keys.size();
+    Rng rng(seed);
+    int first_index = rng() % keys.size();
     centroids.push_back(m_tasks.at(keys[first_index]));
 
+    // distances[j] 为任务到已选中心的最近距离，每选出一个新中心只需与它比较
+    std::vector<double> distances(keys.size(),
+                                  std::numeric_limits<double>::max());
+    size_t compared = 0;
     for (int i = 1; i < k; ++i) {
-        std::vector<double> distances;
         double sum_distances = 0.0;
-        for (const auto &pair : m_tasks) {
-            auto task = pair.second;
-            if (!task) {
-                throw std::runtime_error(
-                    "Null task encountered in initCentroidsKMeansPlusPlus");
-            }
-            double min_dist = std::numeric_limits<double>::max();
-            for (auto centroid : centroids) {
-                if (!centroid) {
+        for (size_t j = 0; j < keys.size(); ++j) {
+            const auto &task = m_tasks.at(keys[j]);
+            for (size_t c = compared; c < centroids.size(); ++c) {
+                if (!centroids[c]) {
                     throw std::runtime_error("Null centroid encountered in "
                                              "initCentroidsKMeansPlusPlus");
                 }
-                double dist = euclideanDistance(task, centroid);
-                min_dist = std::min(min_dist, dist);
+                distances[j] = std::min(distances[j],
+                                        euclideanDistance(task, centroids[c]));
             }
-            distances.push_back(min_dist);
-            sum_distances += min_dist;
+            sum_distances += distances[j];
         }
+        compared = centroids.size();
 
         // 根据距离权重随机选择下一个聚类中心
-        double random_value =
-            static_cast<double>(std::rand()) / RAND_MAX * sum_distances;
+        double random_value = rng.uniform01() * sum_distances;
         double cumulative_distance = 0.0;
         int chosen_index = 0;
         for (size_t j = 0; j < distances.size(); ++j) {
@@ -76,7 +88,7 @@ auto kmeanspp::assignTasks(const std::unordered_map<int, TaskRef> &m_tasks,
                            const std::vector<TaskRef> &centroids,
                            std::unordered_map<int, int> &assignments) -> void {
     for (const auto &pair : m_tasks) {
-        auto task = pair.second;
+        const auto &task = pair.second;
         double min_dist = std::numeric_limits<double>::max();
         int cluster_idx = -1;
         for (size_t i = 0; i < centroids.size(); ++i) {
@@ -95,29 +107,25 @@ auto kmeanspp::updateCentroids(const std::unordered_map<int, TaskRef> &m_tasks,
                                std::vector<TaskRef> &centroids) -> void {
     int num_clusters = centroids.size();
     std::vector<int> count(num_clusters, 0);
-    std::vector<TaskRef> new_centroids;
-    new_centroids.resize(num_clusters);
-    for (int i = 0; i < num_clusters; ++i) {
-        new_centroids[i] = std::make_shared<Task>(i, 0, 0, 0, 0);
-    }
+    std::vector<Centroid> sums(num_clusters);
 
     for (const auto &pair : m_tasks) {
         int cluster_idx = assignments.at(pair.first);
-        auto task = pair.second;
-        new_centroids[cluster_idx]->addClb(task->getClb());
-        new_centroids[cluster_idx]->addDsp(task->getDsp());
-        new_centroids[cluster_idx]->addBram(task->getBram());
+        const auto &task = pair.second;
+        sums[cluster_idx].clb += task->getClb();
+        sums[cluster_idx].dsp += task->getDsp();
+        sums[cluster_idx].bram += task->getBram();
         count[cluster_idx]++;
     }
 
     for (int i = 0; i < num_clusters; ++i) {
         if (count[i] > 0) {
-            centroids[i] =
-                std::make_shared<Task>(i, new_centroids[i]->getClb() / count[i],
-                                       new_centroids[i]->getDsp() / count[i],
-                                       new_centroids[i]->getBram() / count[i],
-                                       0 // 执行时间暂时忽略
-                );
+            centroids[i] = std::make_shared<Task>(
+                i, static_cast<int>(sums[i].clb / count[i]),
+                static_cast<int>(sums[i].dsp / count[i]),
+                static_cast<int>(sums[i].bram / count[i]),
+                0 // 执行时间暂时忽略
+            );
         }
     }
 }
@@ -138,34 +146,321 @@ auto kmeanspp::kMeansPlusPlusClustering(
     const std::unordered_map<int, TaskRef> &m_tasks,
     std::vector<TaskRef> &centroids, std::unordered_map<int, int> &assignments,
     double tolerance, int max_iterations) -> void {
-    initCentroidsKMeansPlusPlus(m_tasks, centroids, centroids.size());
-    int iteration = 0;
-    std::vector<TaskRef> old_centroids;
-    do {
-        old_centroids = centroids;
-        assignTasks(m_tasks, centroids, assignments);
-        updateCentroids(m_tasks, assignments, centroids);
-        iteration++;
-    } while (!isConverged(old_centroids, centroids, tolerance) &&
-             iteration < max_iterations);
+    // 转成按列存储的任务表后统一走 TaskTable 路径
+    auto table = TaskTable::from_map(m_tasks);
+    std::vector<Centroid> table_centroids(centroids.size());
+    std::vector<int> row_assignments;
+    kMeansPlusPlusClustering(table, table_centroids, row_assignments,
+                             tolerance, max_iterations);
+
+    for (size_t i = 0; i < centroids.size(); ++i) {
+        const auto &c = table_centroids[i];
+        centroids[i] = std::make_shared<Task>(
+            i, static_cast<int>(c.clb), static_cast<int>(c.dsp),
+            static_cast<int>(c.bram), 0);
+    }
+    auto ids = table.ids();
+    for (size_t row = 0; row < table.size(); ++row) {
+        assignments[ids[row]] = row_assignments[row];
+    }
 }
 
 auto kmeanspp::getClusterMaxResourcesNumber(
-    std::unordered_map<int, std::vector<int>> clusterToTask,
-    std::unordered_map<int, TaskRef> task_set)
+    const std::unordered_map<int, std::vector<int>> &clusterToTask,
+    const std::unordered_map<int, TaskRef> &task_set)
     -> std::unordered_map<int, std::tuple<int, int, int>> {
     std::unordered_map<int, std::tuple<int, int, int>> res;
+    res.reserve(clusterToTask.size());
     for (const auto &[k, v] : clusterToTask) {
         int clb = INT_MIN, dsp = INT_MIN, bram = INT_MIN;
         for (auto i : v) {
-            clb = std::max(clb, task_set.at(i)->getClb());
-            dsp = std::max(dsp, task_set.at(i)->getDsp());
-            bram = std::max(bram, task_set.at(i)->getBram());
+            const auto &task = *task_set.at(i);
+            clb = std::max(clb, task.getClb());
+            dsp = std::max(dsp, task.getDsp());
+            bram = std::max(bram, task.getBram());
         }
-        auto tuple = std::make_tuple(clb, dsp, bram);
-        res[k] = tuple;
+        res.emplace(k, std::make_tuple(clb, dsp, bram));
     }
     return res;
 }
 
+auto kmeanspp::euclideanDistance(const TaskTable &tasks, size_t row,
+                                 const Centroid &c) -> double {
+    double d_clb = tasks.clb()[row] - c.clb;
+    double d_dsp = tasks.dsp()[row] - c.dsp;
+    double d_bram = tasks.bram()[row] - c.bram;
+    return std::sqrt(d_clb * d_clb + d_dsp * d_dsp + d_bram * d_bram);
+}
+
+auto kmeanspp::initCentroidsKMeansPlusPlus(const TaskTable &tasks,
+                                           std::vector<Centroid> &centroids,
+                                           int k, std::uint64_t seed) -> void {
+    centroids.clear();
+    if (k <= 0) {
+        return;
+    }
+    if (tasks.empty()) {
+        throw std::runtime_error(
+            "Empty task table in initCentroidsKMeansPlusPlus");
+    }
+    auto clb = tasks.clb();
+    auto dsp = tasks.dsp();
+    auto bram = tasks.bram();
+    auto at = [&](size_t row) {
+        return Centroid{static_cast<double>(clb[row]),
+                        static_cast<double>(dsp[row]),
+                        static_cast<double>(bram[row])};
+    };
+
+    centroids.reserve(k);
+    // 随机选择第一个聚类中心
+    Rng rng(seed);
+    centroids.push_back(at(rng() % tasks.size()));
+
+    // distances[row] 为到已选中心的最近距离，每轮只与新中心比较
+    std::vector<double> distances(tasks.size(),
+                                  std::numeric_limits<double>::max());
+    for (int i = 1; i < k; ++i) {
+        const auto &newest = centroids.back();
+        double sum_distances = 0.0;
+        for (size_t row = 0; row < tasks.size(); ++row) {
+            distances[row] = std::min(distances[row],
+                                      euclideanDistance(tasks, row, newest));
+            sum_distances += distances[row];
+        }
+
+        // 根据距离权重随机选择下一个聚类中心
+        double random_value = rng.uniform01() * sum_distances;
+        double cumulative_distance = 0.0;
+        size_t chosen_index = 0;
+        for (size_t j = 0; j < distances.size(); ++j) {
+            cumulative_distance += distances[j];
+            if (cumulative_distance >= random_value) {
+                chosen_index = j;
+                break;
+            }
+        }
+        centroids.push_back(at(chosen_index));
+    }
+}
+
+auto kmeanspp::assignTasks(const TaskTable &tasks,
+                           const std::vector<Centroid> &centroids,
+                           std::vector<int> &assignments) -> void {
+    assignments.resize(tasks.size());
+    for (size_t row = 0; row < tasks.size(); ++row) {
+        double min_dist = std::numeric_limits<double>::max();
+        int cluster_idx = -1;
+        for (size_t i = 0; i < centroids.size(); ++i) {
+            double dist = euclideanDistance(tasks, row, centroids[i]);
+            if (dist < min_dist) {
+                min_dist = dist;
+                cluster_idx = i;
+            }
+        }
+        assignments[row] = cluster_idx;
+    }
+}
+
+auto kmeanspp::updateCentroids(const TaskTable &tasks,
+                               const std::vector<int> &assignments,
+                               std::vector<Centroid> &centroids) -> void {
+    std::vector<Centroid> sums(centroids.size());
+    std::vector<int> count(centroids.size(), 0);
+    auto clb = tasks.clb();
+    auto dsp = tasks.dsp();
+    auto bram = tasks.bram();
+    for (size_t row = 0; row < tasks.size(); ++row) {
+        auto &sum = sums[assignments[row]];
+        sum.clb += clb[row];
+        sum.dsp += dsp[row];
+        sum.bram += bram[row];
+        count[assignments[row]]++;
+    }
+
+    // 空类保持原来的聚类中心
+    for (size_t i = 0; i < centroids.size(); ++i) {
+        if (count[i] > 0) {
+            centroids[i] = {sums[i].clb / count[i], sums[i].dsp / count[i],
+                            sums[i].bram / count[i]};
+        }
+    }
+}
+
+auto kmeanspp::isConverged(const std::vector<Centroid> &old_centroids,
+                           const std::vector<Centroid> &new_centroids,
+                           double tolerance) -> bool {
+    for (size_t i = 0; i < old_centroids.size(); ++i) {
+        double d_clb = old_centroids[i].clb - new_centroids[i].clb;
+        double d_dsp = old_centroids[i].dsp - new_centroids[i].dsp;
+        double d_bram = old_centroids[i].bram - new_centroids[i].bram;
+        if (std::sqrt(d_clb * d_clb + d_dsp * d_dsp + d_bram * d_bram) >
+            tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto kmeanspp::kMeansPlusPlusClustering(const TaskTable &tasks,
+                                        std::vector<Centroid> &centroids,
+                                        std::vector<int> &assignments,
+                                        double tolerance, int max_iterations)
+    -> void {
+    ClusterOptions options;
+    options.tolerance = tolerance;
+    options.max_iterations = max_iterations;
+    kMeansPlusPlusClustering(tasks, centroids, assignments, options);
+}
+
+auto kmeanspp::kMeansPlusPlusClustering(const TaskTable &tasks,
+                                        std::vector<Centroid> &centroids,
+                                        std::vector<int> &assignments,
+                                        const ClusterOptions &options)
+    -> ClusterStats {
+    int k = centroids.size();
+    PackedTasks packed;
+    if (options.seeding == SeedMode::KMEANS_PARALLEL ||
+        options.engine != AssignEngine::LLOYD) {
+        packed = PackedTasks::from_table(tasks);
+    }
+
+    if (options.seeding == SeedMode::KMEANS_PARALLEL) {
+        centroids = kmeans_parallel::seed(packed, k, options);
+    } else if (options.seeding == SeedMode::KMEANSPP) {
+        initCentroidsKMeansPlusPlus(tasks, centroids, k, options.seed);
+    }
+
+    ClusterStats stats;
+    if (options.engine != AssignEngine::LLOYD) {
+        // INCREMENTAL 没有任务改变归属时才停止，不使用 tolerance
+        const bool incremental = options.engine == AssignEngine::INCREMENTAL;
+        kmeans_hamerly engine(packed, incremental);
+        stats.iterations = engine.run(centroids, assignments,
+                                      incremental ? 0.0 : options.tolerance,
+                                      options.max_iterations);
+        stats.moved_tasks = engine.moved_tasks();
+        stats.distance_evaluations = engine.distance_evaluations();
+        return stats;
+    }
+
+    std::vector<Centroid> old_centroids;
+    std::vector<int> old_assignments;
+    do {
+        old_centroids = centroids;
+        old_assignments.assign(assignments.begin(), assignments.end());
+        assignTasks(tasks, centroids, assignments);
+        updateCentroids(tasks, assignments, centroids);
+        stats.distance_evaluations += static_cast<long>(tasks.size()) * k;
+        if (stats.iterations > 0) {
+            for (size_t row = 0; row < assignments.size(); ++row) {
+                stats.moved_tasks += assignments[row] != old_assignments[row];
+            }
+        }
+        stats.iterations++;
+    } while (!isConverged(old_centroids, centroids, options.tolerance) &&
+             stats.iterations < options.max_iterations);
+    return stats;
+}
+
+auto kmeanspp::kMeansPlusPlusRestarts(const TaskTable &tasks, int k,
+                                      int restarts,
+                                      const ClusterOptions &options,
+                                      RestartCriterion criterion)
+    -> ClusterResult {
+    if (restarts <= 0) {
+        throw std::runtime_error("kMeansPlusPlusRestarts needs restarts > 0");
+    }
+    std::vector<ClusterResult> results(restarts);
+    auto run = [&](size_t r) {
+        ClusterOptions restart_options = options;
+        restart_options.seed = options.seed + r;
+        restart_options.pool = nullptr;
+
+        auto &result = results[r];
+        result.seed = restart_options.seed;
+        result.centroids.resize(k);
+        result.stats = kMeansPlusPlusClustering(
+            tasks, result.centroids, result.assignments, restart_options);
+        if (criterion == RestartCriterion::INERTIA) {
+            result.score = inertia(tasks, result.centroids, result.assignments);
+        } else {
+            result.score = 0;
+            for (const auto &[clb, dsp, bram] :
+                 getClusterMaxResourcesNumber(tasks, result.assignments, k)) {
+                result.score += clb + dsp + bram;
+            }
+        }
+    };
+
+    if (options.pool != nullptr) {
+        options.pool->parallel_for(
+            0, restarts, 1,
+            [&](size_t lo, size_t hi, size_t) {
+                for (size_t r = lo; r < hi; ++r) {
+                    run(r);
+                }
+            });
+    } else {
+        for (int r = 0; r < restarts; ++r) {
+            run(r);
+        }
+    }
+
+    size_t best = 0;
+    for (size_t r = 1; r < results.size(); ++r) {
+        if (results[r].score < results[best].score) {
+            best = r;
+        }
+    }
+    return std::move(results[best]);
+}
+
+auto kmeanspp::inertia(const TaskTable &tasks,
+                       const std::vector<Centroid> &centroids,
+                       const std::vector<int> &assignments) -> double {
+    auto clb = tasks.clb();
+    auto dsp = tasks.dsp();
+    auto bram = tasks.bram();
+    double sum = 0.0;
+    for (size_t row = 0; row < tasks.size(); ++row) {
+        const auto &c = centroids[assignments[row]];
+        double dx = clb[row] - c.clb;
+        double dy = dsp[row] - c.dsp;
+        double dz = bram[row] - c.bram;
+        sum += dx * dx + dy * dy + dz * dz;
+    }
+    return sum;
+}
+
+auto kmeanspp::getClusterMaxResourcesNumber(const TaskTable &tasks,
+                                            const std::vector<int> &assignments,
+                                            int k)
+    -> std::vector<std::tuple<int, int, int>> {
+    std::vector<std::tuple<int, int, int>> res(k, {0, 0, 0});
+    auto clb = tasks.clb();
+    auto dsp = tasks.dsp();
+    auto bram = tasks.bram();
+    for (size_t row = 0; row < tasks.size(); ++row) {
+        auto &[c, d, b] = res[assignments[row]];
+        c = std::max(c, clb[row]);
+        d = std::max(d, dsp[row]);
+        b = std::max(b, bram[row]);
+    }
+    return res;
+}
+
+auto kmeanspp::kMeansPlusPlusClustering(TaskStream &stream,
+                                        std::vector<Centroid> &centroids,
+                                        const ClusterOptions &options)
+    -> ClusterStats {
+    return kmeans_minibatch::cluster(stream, centroids, options);
+}
+
+auto kmeanspp::getClusterMaxResourcesNumber(
+    TaskStream &stream, const std::vector<Centroid> &centroids,
+    std::size_t batch_size) -> std::vector<std::tuple<int, int, int>> {
+    return kmeans_minibatch::max_resources(stream, centroids, batch_size);
+}
+
 } // namespace seu
@@ -3,17 +3,14 @@
 namespace seu {
 
 Task::Task(int clb, int dsp, int bram, int exec)
-    : m_clb(clb), m_dsp(dsp), m_bram(bram), m_exectime(exec) {
-    m_children.clear();
-    m_parent.clear();
-    m_status = TaskStatus::WAITING;
-}
+    : m_clb(clb), m_dsp(dsp), m_bram(bram), m_exectime(exec) {}
 
 Task::Task(int id, int clb, int dsp, int bram, int exec)
-    : m_id(id), m_clb(clb), m_dsp(dsp), m_bram(bram), m_exectime(exec) {
-    m_children.clear();
-    m_parent.clear();
-    m_status = TaskStatus::WAITING;
-}
+    : m_id(id), m_clb(clb), m_dsp(dsp), m_bram(bram), m_exectime(exec) {}
+
+Task::Task(int id, int clb, int dsp, int bram, int exec, vector<int> children,
+           vector<int> parents)
+    : m_id(id), m_clb(clb), m_dsp(dsp), m_bram(bram), m_exectime(exec),
+      m_children(std::move(children)), m_parent(std::move(parents)) {}
 
 } // namespace seu
@@ -0,0 +1,127 @@
+#include "task_graph.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace seu {
+
+TaskGraph::TaskGraph(const TaskTable &tasks) {
+    const std::size_t n = tasks.size();
+    auto exec = tasks.exec();
+    auto conf = tasks.conf();
+
+    // Kahn：入度为 0 的任务依次出队，m_order 同时充当队列
+    std::vector<int> indegree(n, 0);
+    for (std::size_t row = 0; row < n; ++row) {
+        indegree[row] = static_cast<int>(tasks.parents(row).size());
+    }
+    m_order.reserve(n);
+    for (std::size_t row = 0; row < n; ++row) {
+        if (indegree[row] == 0) {
+            m_order.push_back(static_cast<int>(row));
+        }
+    }
+    for (std::size_t head = 0; head < m_order.size(); ++head) {
+        for (auto child : tasks.children(m_order[head])) {
+            if (--indegree[child] == 0) {
+                m_order.push_back(child);
+            }
+        }
+    }
+    if (m_order.size() != n) {
+        auto cycle = find_cycle(tasks);
+        std::string ids;
+        for (auto row : cycle) {
+            ids += (ids.empty() ? "" : " -> ") +
+                   std::to_string(tasks.ids()[row]);
+        }
+        throw std::runtime_error("Task dependency cycle: " + ids);
+    }
+
+    // 按拓扑序计算层次与最早完成时间
+    m_level.assign(n, 0);
+    m_finish.assign(n, 0);
+    m_critical_parent.assign(n, -1);
+    int max_level = 0;
+    for (auto row : m_order) {
+        long start = 0;
+        for (auto parent : tasks.parents(row)) {
+            m_level[row] = std::max(m_level[row], m_level[parent] + 1);
+            if (m_finish[parent] > start) {
+                start = m_finish[parent];
+                m_critical_parent[row] = parent;
+            }
+        }
+        m_finish[row] = start + conf[row] + exec[row];
+        max_level = std::max(max_level, m_level[row]);
+        if (m_critical_end < 0 || m_finish[row] > m_critical_length) {
+            m_critical_length = m_finish[row];
+            m_critical_end = row;
+        }
+    }
+
+    // 按层次分组，同一层内保持拓扑序
+    m_level_offsets.assign(n > 0 ? max_level + 2 : 1, 0);
+    for (std::size_t row = 0; row < n; ++row) {
+        m_level_offsets[m_level[row] + 1]++;
+    }
+    for (std::size_t l = 1; l < m_level_offsets.size(); ++l) {
+        m_level_offsets[l] += m_level_offsets[l - 1];
+    }
+    m_level_rows.resize(n);
+    std::vector<int> next(m_level_offsets.begin(), m_level_offsets.end() - 1);
+    for (auto row : m_order) {
+        m_level_rows[next[m_level[row]]++] = row;
+    }
+}
+
+auto TaskGraph::critical_path() const -> std::vector<int> {
+    std::vector<int> path;
+    for (int row = m_critical_end; row >= 0; row = m_critical_parent[row]) {
+        path.push_back(row);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+// 迭代 DFS（白/灰/黑三色），遇到指向灰色任务的边时沿栈取出环
+auto TaskGraph::find_cycle(const TaskTable &tasks) -> std::vector<int> {
+    enum : char { WHITE, GRAY, BLACK };
+    const std::size_t n = tasks.size();
+    std::vector<char> color(n, WHITE);
+    std::vector<std::pair<int, std::size_t>> stack; // (行号, 下一个子任务)
+    for (std::size_t root = 0; root < n; ++root) {
+        if (color[root] != WHITE) {
+            continue;
+        }
+        stack.emplace_back(static_cast<int>(root), 0);
+        color[root] = GRAY;
+        while (!stack.empty()) {
+            auto &[row, next] = stack.back();
+            auto children = tasks.children(row);
+            if (next == children.size()) {
+                color[row] = BLACK;
+                stack.pop_back();
+                continue;
+            }
+            int child = children[next++];
+            if (color[child] == GRAY) {
+                std::vector<int> cycle;
+                auto it = std::find_if(
+                    stack.begin(), stack.end(),
+                    [child](const auto &frame) { return frame.first == child; });
+                for (; it != stack.end(); ++it) {
+                    cycle.push_back(it->first);
+                }
+                return cycle;
+            }
+            if (color[child] == WHITE) {
+                color[child] = GRAY;
+                stack.emplace_back(child, 0);
+            }
+        }
+    }
+    return {};
+}
+
+} // namespace seu
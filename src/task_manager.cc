@@ -1,73 +1,207 @@
 #include "task_manager.h"
-#include "utils.h"
-#include "json/include/json/json.h"
-#include <fstream>
+#include "rng.h"
+#include "task_set_file.h"
+#include "task_source.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <ostream>
-#include <random>
-#include <sstream>
 
 namespace seu {
 
+namespace {
+
+// 批量生成时每块的任务数，每块有独立的随机流
+constexpr std::size_t GENERATOR_CHUNK = 1 << 16;
+
+auto fraction(Rng &rng, int base, std::pair<double, double> range) -> int {
+    return rng.uniform_int(static_cast<int>(base * range.first),
+                           static_cast<int>(base * range.second));
+}
+
+// 按 spec 填充 table 中从 first_row 开始的 n 行
+auto fill_generated(TaskTable &table, std::size_t first_row, std::size_t n,
+                    const TaskGenSpec &spec, ThreadPool *pool) -> void {
+    auto clb = table.mutable_clb().subspan(first_row, n);
+    auto dsp = table.mutable_dsp().subspan(first_row, n);
+    auto bram = table.mutable_bram().subspan(first_row, n);
+    auto exec = table.mutable_exec().subspan(first_row, n);
+
+    auto fill = [&](std::size_t lo, std::size_t hi, std::size_t chunk) {
+        Rng rng = Rng::stream(spec.seed, chunk);
+        for (std::size_t i = lo; i < hi; ++i) {
+            switch (spec.shape) {
+            case TaskShape::UNIFORM:
+                clb[i] = rng.uniform_int(spec.clb.first, spec.clb.second);
+                dsp[i] = rng.uniform_int(spec.dsp.first, spec.dsp.second);
+                bram[i] = rng.uniform_int(spec.bram.first, spec.bram.second);
+                break;
+            case TaskShape::CLB_FRACTION:
+                clb[i] = rng.uniform_int(spec.clb.first, spec.clb.second);
+                dsp[i] = fraction(rng, clb[i], spec.dsp_fraction);
+                bram[i] = fraction(rng, clb[i], spec.bram_fraction);
+                break;
+            case TaskShape::NORMAL:
+                clb[i] = static_cast<int>(std::clamp(
+                    std::round(rng.normal(spec.clb_mean, spec.clb_stddev)),
+                    static_cast<double>(spec.clb.first),
+                    static_cast<double>(spec.clb.second)));
+                dsp[i] = fraction(rng, clb[i], spec.dsp_fraction);
+                bram[i] = fraction(rng, clb[i], spec.bram_fraction);
+                break;
+            }
+            exec[i] = rng.uniform_int(spec.exec.first, spec.exec.second);
+        }
+    };
+
+    if (pool != nullptr) {
+        pool->parallel_for(0, n, GENERATOR_CHUNK, fill);
+    } else {
+        for (std::size_t lo = 0; lo < n; lo += GENERATOR_CHUNK) {
+            fill(lo, std::min(n, lo + GENERATOR_CHUNK), lo / GENERATOR_CHUNK);
+        }
+    }
+}
+
+} // namespace
+
 auto TaskManager::init_from_json(const std::string &filename) -> void {
-    std::string root_path = Utils::get_project_root();
-    std::string path = root_path + "/src/info/taskinfo/" + filename;
-    std::ifstream jsonFile(path);
-    if (!jsonFile.is_open()) {
-        std::cerr << "TM Failed to open JSON file" << std::endl;
+    std::string path = TaskSource::default_dir() + "/" + filename;
+
+    // 先解析到临时表，整个文件解析成功后再合并
+    TaskTable loaded;
+    try {
+        loaded = TaskSource::load_file(path);
+    } catch (const std::runtime_error &e) {
+        std::cerr << "TM Failed to load JSON: " << e.what() << std::endl;
         return;
     }
+    task_num += static_cast<int>(loaded.size());
+    merge_loaded(std::move(loaded));
+}
 
-    // 读取文件内容到字符串
-    std::stringstream buffer;
-    buffer << jsonFile.rdbuf();
-
-    // 关闭文件
-    jsonFile.close();
+auto TaskManager::init_from_source(const TaskSource &source, IdRemap remap,
+                                   ThreadPool *pool) -> std::vector<TaskShard> {
+    TaskSourceResult result;
+    try {
+        result = source.load(remap, pool);
+    } catch (const std::runtime_error &e) {
+        std::cerr << "TM Failed to load task source: " << e.what()
+                  << std::endl;
+        return {};
+    }
+    task_num += static_cast<int>(result.table.size());
+    merge_loaded(std::move(result.table));
+    return result.shards;
+}
 
-    // 解析 JSON 字符串
-    Json::Value root;
-    Json::Reader reader;
-    if (!reader.parse(buffer.str(), root)) {
-        std::cerr << "Failed to parse JSON: "
-                  << reader.getFormattedErrorMessages() << std::endl;
+auto TaskManager::init_from_binary(const std::string &filename) -> void {
+    std::string path = TaskSource::default_dir() + "/" + filename;
+    TaskTable loaded;
+    try {
+        loaded = TaskSetFile(path).to_table();
+    } catch (const std::runtime_error &e) {
+        std::cerr << "TM Failed to load task set: " << e.what() << std::endl;
         return;
     }
+    task_num += static_cast<int>(loaded.size());
+    merge_loaded(std::move(loaded));
+}
 
-    const Json::Value &tasks = root["tasks"];
-    for (const auto &task : tasks) {
-        int id = task["id"].asInt();
-        int clb = task["clb"].asInt();
-        int dsp = task["dsp"].asInt();
-        int bram = task["bram"].asInt();
-        int exectime = task["exectime"].asInt();
+auto TaskManager::save_binary(const std::string &filename) const -> void {
+    std::string path = TaskSource::default_dir() + "/" + filename;
+    try {
+        TaskSetFile::save(path, m_table);
+    } catch (const std::runtime_error &e) {
+        std::cerr << "TM Failed to save task set: " << e.what() << std::endl;
+    }
+}
 
-        auto t = std::make_shared<Task>(id, clb, dsp, bram, exectime);
-        m_tasks[id] = t;
+auto TaskManager::merge_loaded(TaskTable &&loaded) -> void {
+    m_map.reset();
+    if (m_table.size() == 0) {
+        m_table = std::move(loaded);
+        return;
+    }
+    auto edges = m_table.edges();
+    auto loaded_edges = loaded.edges();
+    edges.insert(edges.end(), loaded_edges.begin(), loaded_edges.end());
 
-        task_num++;
+    m_table.reserve(m_table.size() + loaded.size());
+    auto ids = loaded.ids();
+    auto clb = loaded.clb();
+    auto dsp = loaded.dsp();
+    auto bram = loaded.bram();
+    auto exec = loaded.exec();
+    auto conf = loaded.conf();
+    for (std::size_t row = 0; row < loaded.size(); ++row) {
+        if (m_table.contains(ids[row])) {
+            m_table.set_row(m_table.row_of(ids[row]), clb[row], dsp[row],
+                            bram[row], exec[row], conf[row]);
+        } else {
+            m_table.push_back(ids[row], clb[row], dsp[row], bram[row],
+                              exec[row], conf[row]);
+        }
+    }
+    // 行号变化后依赖关系需要按 id 重建
+    if (m_table.has_edges() || loaded.has_edges()) {
+        m_table.set_edges(edges);
     }
-    return;
 }
 
 auto TaskManager::init_from_random() -> void {
     auto n = random_int_gen(5, 25); // 任务节点数
-    for (int i = 0; i < n; i++) {
-        auto task = task_info_init();
-        m_random_task.insert({m_taskid, task});
-        m_taskid++;
-    }
+    init_from_random(n);
 }
 
 auto TaskManager::init_from_random(int n) -> void {
+    m_random_map.reset();
+    m_random_table.reserve(m_random_table.size() + n);
     for (int i = 0; i < n; i++) {
-        auto task = task_info_init();
-        m_random_task.insert({m_taskid, task});
+        // 分布与取值顺序同 task_info_init，直接写入任务表，不构造 Task
+        auto clb = random_int_gen(2000, 3000);
+        auto dsp = random_int_gen(0, 80);
+        auto bram = random_int_gen(0, 80);
+        auto exec = random_int_gen(5, 50);
+        m_random_table.push_back(m_taskid, clb, dsp, bram, exec);
         m_taskid++;
     }
 }
 
+auto TaskManager::init_from_generator(std::size_t n, const TaskGenSpec &spec,
+                                      ThreadPool *pool) -> void {
+    m_random_map.reset();
+    auto row = m_random_table.append_rows(m_taskid, n);
+    fill_generated(m_random_table, row, n, spec, pool);
+    m_taskid += static_cast<int>(n);
+}
+
+auto TaskManager::generate_task_table(std::size_t n, const TaskGenSpec &spec,
+                                      int first_id, ThreadPool *pool)
+    -> TaskTable {
+    TaskTable table;
+    table.append_rows(first_id, n);
+    fill_generated(table, 0, n, spec, pool);
+    return table;
+}
+
+auto TaskManager::getRandomTask()
+    -> const std::unordered_map<int, TaskRef> & {
+    if (!m_random_map) {
+        m_random_map = m_random_table.to_map();
+    }
+    return *m_random_map;
+}
+
+auto TaskManager::getJsonTask() -> const std::unordered_map<int, TaskRef> & {
+    if (!m_map) {
+        m_map = m_table.to_map();
+    }
+    return *m_map;
+}
+
 auto TaskManager::task_info_init() -> TaskRef {
     auto clb = random_int_gen(2000, 3000);
     auto dsp = random_int_gen(0, 80);
@@ -91,14 +225,22 @@ auto TaskManager::task_info_init_custom(std::pair<int, int> clb,
 }
 
 auto TaskManager::random_int_gen(int lower, int upper) -> int {
-    std::random_device rd;  // 随机数生成器
-    std::mt19937 gen(rd()); // 以随机设备作为种子的 Mersenne Twister 生成器
-    std::uniform_int_distribution<> distr(lower,
-                                          upper); //  均匀分布的整数分布
-    return distr(gen);                            //
+    return RngService::local().uniform_int(lower, upper);
+}
+
+auto TaskManager::generate_normal_distribution(double mean, double stddev,
+                                               int size)
+    -> std::vector<double> {
+    auto &rng = RngService::local();
+    std::vector<double> res(size);
+    for (auto &v : res) {
+        v = rng.normal(mean, stddev);
+    }
+    return res;
 }
 
-void TaskManager::TaskInfoPrint(std::unordered_map<int, TaskRef> TaskSet) {
+void TaskManager::TaskInfoPrint(
+    const std::unordered_map<int, TaskRef> &TaskSet) {
     for (const auto &[k, v] : TaskSet) {
         std::cout << "task_id: " << k << "  resources: " << v->getClb() << " "
                   << v->getDsp() << " " << v->getBram() << std::endl;
@@ -0,0 +1,151 @@
+#include "task_set_file.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "task_set_file assumes a little-endian host"
+#endif
+
+namespace seu {
+
+static_assert(sizeof(int) == sizeof(std::int32_t), "int must be 32 bits");
+
+namespace {
+
+constexpr std::size_t SECTION_ALIGN = 64;
+constexpr int SECTION_COUNT = 10;
+
+auto align_up(std::size_t n) -> std::size_t {
+    return (n + SECTION_ALIGN - 1) / SECTION_ALIGN * SECTION_ALIGN;
+}
+
+// 第 i 段的元素个数
+auto section_length(int section, std::size_t tasks, std::size_t edges,
+                    bool has_edges) -> std::size_t {
+    if (section < 6) {
+        return tasks;
+    }
+    if (section < 8) {
+        return has_edges ? tasks + 1 : 0;
+    }
+    return edges;
+}
+
+// 各段的起始字节偏移，最后一项为文件大小
+auto section_offsets(std::size_t tasks, std::size_t edges, bool has_edges)
+    -> std::vector<std::size_t> {
+    std::vector<std::size_t> offsets(SECTION_COUNT + 1);
+    offsets[0] = sizeof(TaskSetHeader);
+    for (int i = 0; i < SECTION_COUNT; ++i) {
+        offsets[i + 1] = align_up(
+            offsets[i] +
+            section_length(i, tasks, edges, has_edges) * sizeof(std::int32_t));
+    }
+    return offsets;
+}
+
+} // namespace
+
+TaskSetFile::TaskSetFile(const std::string &path)
+    : m_path(path), m_mapped(path) {
+    if (m_mapped.size() < sizeof(TaskSetHeader)) {
+        throw std::runtime_error("Truncated task set file: " + path);
+    }
+    std::memcpy(&m_header, m_mapped.data(), sizeof(TaskSetHeader));
+    if (std::memcmp(m_header.magic, TASK_SET_MAGIC, sizeof(TASK_SET_MAGIC)) !=
+        0) {
+        throw std::runtime_error("Not a task set file: " + path);
+    }
+    if (m_header.version != TASK_SET_VERSION ||
+        m_header.header_size != sizeof(TaskSetHeader)) {
+        throw std::runtime_error("Unsupported task set file version: " + path);
+    }
+    // 行号以 int 存储，超出范围的计数只可能来自损坏的文件
+    constexpr auto max_count =
+        static_cast<std::uint64_t>(std::numeric_limits<int>::max());
+    if (m_header.task_count > max_count || m_header.edge_count > max_count) {
+        throw std::runtime_error("Corrupt task set file: " + path);
+    }
+    auto offsets = section_offsets(m_header.task_count, m_header.edge_count,
+                                   m_header.has_edges != 0);
+    if (m_header.file_size != offsets.back() ||
+        m_mapped.size() < offsets.back()) {
+        throw std::runtime_error("Truncated task set file: " + path);
+    }
+}
+
+auto TaskSetFile::column(int section) const -> Span<const int> {
+    auto offsets = section_offsets(m_header.task_count, m_header.edge_count,
+                                   m_header.has_edges != 0);
+    return Span<const int>(
+        reinterpret_cast<const int *>(m_mapped.data() + offsets[section]),
+        section_length(section, m_header.task_count, m_header.edge_count,
+                       m_header.has_edges != 0));
+}
+
+auto TaskSetFile::to_table() const -> TaskTable {
+    TaskTable table;
+    table.reserve(size());
+    auto id = ids();
+    auto c = clb();
+    auto d = dsp();
+    auto b = bram();
+    auto e = exec();
+    auto f = conf();
+    for (std::size_t row = 0; row < size(); ++row) {
+        table.push_back(id[row], c[row], d[row], b[row], e[row], f[row]);
+    }
+    if (m_header.has_edges != 0) {
+        auto to_vector = [&](int section) {
+            auto s = column(section);
+            return std::vector<int>(s.begin(), s.end());
+        };
+        table.set_adjacency(to_vector(6), to_vector(8), to_vector(7),
+                            to_vector(9));
+    }
+    return table;
+}
+
+auto TaskSetFile::save(const std::string &path, const TaskTable &tasks)
+    -> void {
+    TaskSetHeader header{};
+    std::memcpy(header.magic, TASK_SET_MAGIC, sizeof(TASK_SET_MAGIC));
+    header.version = TASK_SET_VERSION;
+    header.header_size = sizeof(TaskSetHeader);
+    header.task_count = tasks.size();
+    header.edge_count = tasks.edge_count();
+    header.has_edges = tasks.has_edges() ? 1 : 0;
+    auto offsets = section_offsets(tasks.size(), tasks.edge_count(),
+                                   tasks.has_edges());
+    header.file_size = offsets.back();
+
+    const Span<const int> sections[SECTION_COUNT] = {
+        tasks.ids(),           tasks.clb(),           tasks.dsp(),
+        tasks.bram(),          tasks.exec(),          tasks.conf(),
+        tasks.child_offsets(), tasks.parent_offsets(), tasks.child_rows(),
+        tasks.parent_rows()};
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to create task set file: " + path);
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    const char zeros[SECTION_ALIGN] = {};
+    std::size_t written = sizeof(header);
+    for (int i = 0; i < SECTION_COUNT; ++i) {
+        out.write(zeros, offsets[i] - written);
+        out.write(reinterpret_cast<const char *>(sections[i].data()),
+                  sections[i].size() * sizeof(std::int32_t));
+        written = offsets[i] + sections[i].size() * sizeof(std::int32_t);
+    }
+    out.write(zeros, offsets.back() - written);
+    if (!out.good()) {
+        throw std::runtime_error("Failed to write task set file: " + path);
+    }
+}
+
+} // namespace seu
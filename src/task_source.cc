@@ -0,0 +1,151 @@
+#include "task_source.h"
+#include "task_set_file.h"
+#include "task_stream.h"
+#include "thread_pool.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace seu {
+
+namespace {
+
+// 预分配任务表各列时按每个任务约占的 JSON 字节数估计任务数；列只预留
+// 容量，估多了不会实际占用内存。id 索引不按估计值预留（见
+// TaskTable::reserve_columns），随读入的任务增长
+constexpr std::size_t JSON_BYTES_PER_TASK = 48;
+
+auto is_binary_task_set(const std::string &path) -> bool {
+    char magic[sizeof(TASK_SET_MAGIC)] = {};
+    std::ifstream file(path, std::ios::binary);
+    file.read(magic, sizeof(magic));
+    return file.gcount() == sizeof(magic) &&
+           std::memcmp(magic, TASK_SET_MAGIC, sizeof(magic)) == 0;
+}
+
+auto load_json(const std::string &path) -> TaskTable {
+    TaskTable table;
+    JsonTaskStream stream(path, JsonReadMode::MAPPED);
+    table.reserve_columns(stream.file_size() / JSON_BYTES_PER_TASK);
+    std::vector<std::pair<int, int>> edges;
+    bool has_edges = false;
+    TaskRecord task;
+    while (stream.next_task(task)) {
+        if (table.contains(task.id)) {
+            table.set_row(table.row_of(task.id), task.clb, task.dsp, task.bram,
+                          task.exec, task.conf);
+        } else {
+            table.push_back(task.id, task.clb, task.dsp, task.bram, task.exec,
+                            task.conf);
+        }
+        for (auto child : task.children) {
+            edges.emplace_back(task.id, child);
+        }
+        has_edges = has_edges || !task.children.empty();
+    }
+    // 子任务可能出现在父任务之后，读完整个文件再建立依赖关系
+    if (has_edges) {
+        table.set_edges(edges);
+    }
+    return table;
+}
+
+} // namespace
+
+TaskSource::TaskSource() : m_base_dir(default_dir()) {}
+
+TaskSource::TaskSource(std::string base_dir) : m_base_dir(std::move(base_dir)) {}
+
+auto TaskSource::default_dir() -> std::string {
+    return Utils::get_project_root() + "/src/info/taskinfo";
+}
+
+auto TaskSource::add(const std::string &path_or_pattern) -> TaskSource & {
+    std::string pattern = path_or_pattern;
+    if (pattern.empty() || pattern[0] != '/') {
+        pattern = m_base_dir + "/" + pattern;
+    }
+    auto matches = Utils::glob(pattern);
+    if (matches.empty()) {
+        throw std::runtime_error("No task file matches: " + pattern);
+    }
+    m_files.insert(m_files.end(), matches.begin(), matches.end());
+    return *this;
+}
+
+auto TaskSource::load_file(const std::string &path) -> TaskTable {
+    if (is_binary_task_set(path)) {
+        return TaskSetFile(path).to_table();
+    }
+    return load_json(path);
+}
+
+auto TaskSource::load(IdRemap remap, ThreadPool *pool) const
+    -> TaskSourceResult {
+    std::vector<TaskTable> tables(m_files.size());
+    auto parse = [&](std::size_t lo, std::size_t hi, std::size_t) {
+        for (std::size_t i = lo; i < hi; ++i) {
+            tables[i] = load_file(m_files[i]);
+        }
+    };
+    if (pool != nullptr) {
+        pool->parallel_for(0, m_files.size(), 1, parse);
+    } else {
+        parse(0, m_files.size(), 0);
+    }
+
+    TaskSourceResult result;
+    std::size_t total = 0;
+    for (const auto &t : tables) {
+        total += t.size();
+    }
+    result.table.reserve(total);
+
+    TaskTable &merged = result.table;
+    std::vector<std::pair<int, int>> edges;
+    bool has_edges = false;
+    long next_offset = 0;
+    for (std::size_t i = 0; i < tables.size(); ++i) {
+        const TaskTable &shard = tables[i];
+        const int offset =
+            remap == IdRemap::OFFSET ? static_cast<int>(next_offset) : 0;
+        auto ids = shard.ids();
+        auto clb = shard.clb();
+        auto dsp = shard.dsp();
+        auto bram = shard.bram();
+        auto exec = shard.exec();
+        auto conf = shard.conf();
+        const int max_id =
+            shard.empty() ? -1 : *std::max_element(ids.begin(), ids.end());
+        if (offset + static_cast<long>(max_id) >=
+            std::numeric_limits<int>::max()) {
+            throw std::runtime_error("Task ids overflow when merging shards");
+        }
+        for (std::size_t row = 0; row < shard.size(); ++row) {
+            const int id = ids[row] + offset;
+            if (merged.contains(id)) {
+                merged.set_row(merged.row_of(id), clb[row], dsp[row],
+                               bram[row], exec[row], conf[row]);
+            } else {
+                merged.push_back(id, clb[row], dsp[row], bram[row], exec[row],
+                                 conf[row]);
+            }
+        }
+        for (const auto &e : shard.edges()) {
+            edges.emplace_back(e.first + offset, e.second + offset);
+        }
+        has_edges = has_edges || shard.has_edges();
+        next_offset = offset + static_cast<long>(max_id) + 1;
+        result.shards.push_back({m_files[i], shard.size(), offset});
+    }
+    if (has_edges) {
+        merged.set_edges(edges);
+    }
+    return result;
+}
+
+} // namespace seu
@@ -0,0 +1,296 @@
+#include "task_stream.h"
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+namespace seu {
+
+auto TableTaskStream::next_batch(std::size_t max_tasks, TaskBatch &batch)
+    -> std::size_t {
+    batch.clear();
+    auto ids = m_tasks.ids();
+    auto clb = m_tasks.clb();
+    auto dsp = m_tasks.dsp();
+    auto bram = m_tasks.bram();
+    auto exec = m_tasks.exec();
+    for (; m_row < m_tasks.size() && batch.size() < max_tasks; ++m_row) {
+        batch.id.push_back(ids[m_row]);
+        batch.clb.push_back(clb[m_row]);
+        batch.dsp.push_back(dsp[m_row]);
+        batch.bram.push_back(bram[m_row]);
+        batch.exec.push_back(exec[m_row]);
+    }
+    return batch.size();
+}
+
+JsonTaskStream::JsonTaskStream(const std::string &path, JsonReadMode mode,
+                               std::size_t buffer_size)
+    : m_path(path), m_mode(mode) {
+    if (m_mode == JsonReadMode::MAPPED) {
+        m_mapped = MappedFile(path);
+        m_file_size = m_mapped.size();
+    } else {
+        m_file.open(path, std::ios::binary | std::ios::ate);
+        if (!m_file.is_open()) {
+            throw std::runtime_error("Failed to open task JSON file: " + path);
+        }
+        m_file_size = static_cast<std::size_t>(m_file.tellg());
+        m_buffer.resize(buffer_size > 0 ? buffer_size : 1);
+    }
+    reset();
+}
+
+auto JsonTaskStream::reset() -> void {
+    if (m_mode == JsonReadMode::MAPPED) {
+        m_data = m_mapped.data();
+        m_len = m_mapped.size();
+    } else {
+        m_file.clear();
+        m_file.seekg(0);
+        m_data = m_buffer.data();
+        m_len = 0;
+    }
+    m_pos = 0;
+    m_done = false;
+    find_tasks_array();
+}
+
+auto JsonTaskStream::next_batch(std::size_t max_tasks, TaskBatch &batch)
+    -> std::size_t {
+    batch.clear();
+    TaskRecord task;
+    while (batch.size() < max_tasks && next_task(task)) {
+        batch.id.push_back(task.id);
+        batch.clb.push_back(task.clb);
+        batch.dsp.push_back(task.dsp);
+        batch.bram.push_back(task.bram);
+        batch.exec.push_back(task.exec);
+    }
+    return batch.size();
+}
+
+auto JsonTaskStream::fail(const std::string &what) -> void {
+    throw std::runtime_error("Malformed task JSON (" + what + "): " + m_path);
+}
+
+// 映射方式下整个文件一次可读，读到末尾即结束
+auto JsonTaskStream::refill() -> bool {
+    if (m_mode == JsonReadMode::MAPPED) {
+        return false;
+    }
+    m_file.read(m_buffer.data(), m_buffer.size());
+    m_len = static_cast<std::size_t>(m_file.gcount());
+    m_pos = 0;
+    return m_len > 0;
+}
+
+auto JsonTaskStream::peek() -> int {
+    if (m_pos == m_len && !refill()) {
+        return EOF;
+    }
+    return static_cast<unsigned char>(m_data[m_pos]);
+}
+
+auto JsonTaskStream::get() -> int {
+    int c = peek();
+    if (c != EOF) {
+        m_pos++;
+    }
+    return c;
+}
+
+auto JsonTaskStream::skip_ws() -> int {
+    int c = get();
+    while (c != EOF && std::isspace(c)) {
+        c = get();
+    }
+    return c;
+}
+
+auto JsonTaskStream::expect(char c) -> void {
+    if (skip_ws() != c) {
+        fail(std::string("expected '") + c + "'");
+    }
+}
+
+// 读取字符串内容，调用时开头的引号已被读取
+auto JsonTaskStream::read_string() -> std::string {
+    std::string s;
+    for (int c = get(); c != '"'; c = get()) {
+        if (c == EOF) {
+            fail("unterminated string");
+        }
+        if (c == '\\') {
+            c = get();
+        }
+        s.push_back(static_cast<char>(c));
+    }
+    return s;
+}
+
+auto JsonTaskStream::read_number(int first) -> double {
+    std::string token(1, static_cast<char>(first));
+    bool integral = first != '.';
+    for (int c = peek(); c != EOF && (std::isdigit(c) || c == '.' || c == 'e' ||
+                                      c == 'E' || c == '+' || c == '-');
+         c = peek()) {
+        integral = integral && std::isdigit(c);
+        token.push_back(static_cast<char>(get()));
+    }
+    // 任务字段几乎都是整数，直接累加，避免 strtod 的开销
+    const std::size_t sign = token[0] == '-' ? 1 : 0;
+    if (integral && token.size() > sign && token.size() - sign < 16) {
+        double value = 0.0;
+        for (std::size_t i = sign; i < token.size(); ++i) {
+            value = value * 10 + (token[i] - '0');
+        }
+        return sign == 1 ? -value : value;
+    }
+    char *end = nullptr;
+    double value = std::strtod(token.c_str(), &end);
+    if (end != token.c_str() + token.size()) {
+        fail("bad number " + token);
+    }
+    return value;
+}
+
+// 读取整数字段，小数或超出 int 范围的值视为格式错误，而不是静默截断
+auto JsonTaskStream::read_int(int first) -> int {
+    const double value = read_number(first);
+    if (!(value >= std::numeric_limits<int>::min() &&
+          value <= std::numeric_limits<int>::max()) ||
+        std::floor(value) != value) {
+        fail("integer out of range " + std::to_string(value));
+    }
+    return static_cast<int>(value);
+}
+
+// 读取整数数组，调用时开头的 '[' 已被读取
+auto JsonTaskStream::read_id_list(std::vector<int> &ids) -> void {
+    while (true) {
+        int c = skip_ws();
+        if (c == ',') {
+            c = skip_ws();
+        }
+        if (c == ']') {
+            return;
+        }
+        if (c != '-' && !std::isdigit(c)) {
+            fail("expected task id");
+        }
+        ids.push_back(read_int(c));
+    }
+}
+
+// 跳过不关心的值，嵌套的对象和数组按深度匹配
+auto JsonTaskStream::skip_value(int first) -> void {
+    if (first == '"') {
+        read_string();
+        return;
+    }
+    if (first != '{' && first != '[') {
+        for (int c = peek(); c != EOF && c != ',' && c != '}' && c != ']' &&
+                             !std::isspace(c);
+             c = peek()) {
+            get();
+        }
+        return;
+    }
+    int depth = 1;
+    while (depth > 0) {
+        int c = get();
+        if (c == EOF) {
+            fail("unterminated value");
+        } else if (c == '"') {
+            read_string();
+        } else if (c == '{' || c == '[') {
+            depth++;
+        } else if (c == '}' || c == ']') {
+            depth--;
+        }
+    }
+}
+
+// 定位到顶层对象中 "tasks" 数组的第一个元素之前
+auto JsonTaskStream::find_tasks_array() -> void {
+    expect('{');
+    while (true) {
+        int c = skip_ws();
+        if (c == ',') {
+            c = skip_ws();
+        }
+        if (c != '"') {
+            fail("no \"tasks\" array");
+        }
+        std::string key = read_string();
+        expect(':');
+        if (key == "tasks") {
+            expect('[');
+            return;
+        }
+        skip_value(skip_ws());
+    }
+}
+
+auto JsonTaskStream::next_task(TaskRecord &task) -> bool {
+    if (m_done) {
+        return false;
+    }
+    int c = skip_ws();
+    if (c == ',') {
+        c = skip_ws();
+    }
+    if (c == ']') {
+        m_done = true;
+        return false;
+    }
+    if (c != '{') {
+        fail("expected task object");
+    }
+
+    task.id = task.clb = task.dsp = task.bram = task.exec = task.conf = 0;
+    task.children.clear();
+    while (true) {
+        c = skip_ws();
+        if (c == ',') {
+            c = skip_ws();
+        }
+        if (c == '}') {
+            break;
+        }
+        if (c != '"') {
+            fail("expected key");
+        }
+        std::string key = read_string();
+        expect(':');
+        c = skip_ws();
+        int *field = nullptr;
+        if (key == "id") {
+            field = &task.id;
+        } else if (key == "clb") {
+            field = &task.clb;
+        } else if (key == "dsp") {
+            field = &task.dsp;
+        } else if (key == "bram") {
+            field = &task.bram;
+        } else if (key == "exectime") {
+            field = &task.exec;
+        } else if (key == "conftime") {
+            field = &task.conf;
+        }
+        if (field != nullptr && (c == '-' || std::isdigit(c))) {
+            *field = read_int(c);
+        } else if (key == "children" && c == '[') {
+            read_id_list(task.children);
+        } else {
+            skip_value(c);
+        }
+    }
+
+    return true;
+}
+
+} // namespace seu
@@ -0,0 +1,245 @@
+#include "task_table.h"
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+namespace seu {
+
+auto TaskTable::reserve(std::size_t n) -> void {
+    reserve_columns(n);
+    m_index.reserve(n);
+}
+
+auto TaskTable::reserve_columns(std::size_t n) -> void {
+    m_id.reserve(n);
+    m_clb.reserve(n);
+    m_dsp.reserve(n);
+    m_bram.reserve(n);
+    m_exec.reserve(n);
+    m_conf.reserve(n);
+}
+
+auto TaskTable::clear() -> void {
+    m_id.clear();
+    m_clb.clear();
+    m_dsp.clear();
+    m_bram.clear();
+    m_exec.clear();
+    m_conf.clear();
+    m_index.clear();
+    m_child_offsets.clear();
+    m_child_rows.clear();
+    m_parent_offsets.clear();
+    m_parent_rows.clear();
+}
+
+auto TaskTable::push_back(int id, int clb, int dsp, int bram, int exec,
+                          int conf) -> std::size_t {
+    std::size_t row = m_id.size();
+    index_insert(id, row);
+    m_id.push_back(id);
+    m_clb.push_back(clb);
+    m_dsp.push_back(dsp);
+    m_bram.push_back(bram);
+    m_exec.push_back(exec);
+    m_conf.push_back(conf);
+    return row;
+}
+
+auto TaskTable::set_row(std::size_t row, int clb, int dsp, int bram, int exec,
+                        int conf) -> void {
+    m_clb[row] = clb;
+    m_dsp[row] = dsp;
+    m_bram[row] = bram;
+    m_exec[row] = exec;
+    m_conf[row] = conf;
+}
+
+auto TaskTable::set_resources(std::size_t first_row, Span<const int> clb,
+                              Span<const int> dsp, Span<const int> bram)
+    -> void {
+    const std::size_t n = clb.size();
+    if (dsp.size() != n || bram.size() != n || first_row + n > size()) {
+        throw std::runtime_error("Resource columns out of range in TaskTable");
+    }
+    std::copy(clb.begin(), clb.end(), m_clb.begin() + first_row);
+    std::copy(dsp.begin(), dsp.end(), m_dsp.begin() + first_row);
+    std::copy(bram.begin(), bram.end(), m_bram.begin() + first_row);
+}
+
+auto TaskTable::append_rows(int first_id, std::size_t n) -> std::size_t {
+    if (first_id < 0) {
+        throw std::runtime_error("Negative task id in TaskTable");
+    }
+    if (n > static_cast<std::size_t>(std::numeric_limits<int>::max() -
+                                     first_id)) {
+        throw std::runtime_error("Task id overflow in TaskTable");
+    }
+    const std::size_t first_row = size();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (m_index.count(first_id + static_cast<int>(i)) != 0) {
+            throw std::runtime_error("Duplicate task id in TaskTable");
+        }
+    }
+    m_index.reserve(m_index.size() + n);
+    m_id.resize(first_row + n);
+    m_clb.resize(first_row + n);
+    m_dsp.resize(first_row + n);
+    m_bram.resize(first_row + n);
+    m_exec.resize(first_row + n);
+    m_conf.resize(first_row + n);
+    for (std::size_t i = 0; i < n; ++i) {
+        m_id[first_row + i] = first_id + static_cast<int>(i);
+        m_index.emplace(m_id[first_row + i], static_cast<int>(first_row + i));
+    }
+    return first_row;
+}
+
+namespace {
+
+// 由 (from, to) 行号对按 from 构建 CSR，同一 from 内保持输入顺序
+auto build_csr(std::size_t n, const std::vector<std::pair<int, int>> &pairs,
+               std::vector<int> &offsets, std::vector<int> &rows) -> void {
+    offsets.assign(n + 1, 0);
+    for (const auto &p : pairs) {
+        offsets[p.first + 1]++;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    rows.resize(pairs.size());
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (const auto &p : pairs) {
+        rows[next[p.first]++] = p.second;
+    }
+}
+
+auto check_csr(std::size_t n, const std::vector<int> &offsets,
+               const std::vector<int> &rows) -> void {
+    if (offsets.size() != n + 1 || offsets[0] != 0 ||
+        static_cast<std::size_t>(offsets[n]) != rows.size()) {
+        throw std::runtime_error("Malformed adjacency in TaskTable");
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (offsets[i] > offsets[i + 1]) {
+            throw std::runtime_error("Malformed adjacency in TaskTable");
+        }
+    }
+    for (auto row : rows) {
+        if (row < 0 || static_cast<std::size_t>(row) >= n) {
+            throw std::runtime_error("Adjacency row out of range in TaskTable");
+        }
+    }
+}
+
+} // namespace
+
+auto TaskTable::set_edges(const std::vector<std::pair<int, int>> &edges)
+    -> void {
+    std::vector<std::pair<int, int>> down, up;
+    down.reserve(edges.size());
+    up.reserve(edges.size());
+    for (const auto &e : edges) {
+        int parent = row_of(e.first);
+        int child = row_of(e.second);
+        if (parent < 0 || child < 0) {
+            throw std::runtime_error("Edge references unknown task id");
+        }
+        down.emplace_back(parent, child);
+        up.emplace_back(child, parent);
+    }
+    build_csr(size(), down, m_child_offsets, m_child_rows);
+    build_csr(size(), up, m_parent_offsets, m_parent_rows);
+}
+
+auto TaskTable::set_adjacency(std::vector<int> child_offsets,
+                              std::vector<int> child_rows,
+                              std::vector<int> parent_offsets,
+                              std::vector<int> parent_rows) -> void {
+    check_csr(size(), child_offsets, child_rows);
+    check_csr(size(), parent_offsets, parent_rows);
+    if (child_rows.size() != parent_rows.size()) {
+        throw std::runtime_error("Mismatched adjacency in TaskTable");
+    }
+    m_child_offsets = std::move(child_offsets);
+    m_child_rows = std::move(child_rows);
+    m_parent_offsets = std::move(parent_offsets);
+    m_parent_rows = std::move(parent_rows);
+}
+
+auto TaskTable::edges() const -> std::vector<std::pair<int, int>> {
+    std::vector<std::pair<int, int>> result;
+    result.reserve(edge_count());
+    for (std::size_t row = 0; row < size() && has_edges(); ++row) {
+        for (auto child : children(row)) {
+            result.emplace_back(m_id[row], m_id[child]);
+        }
+    }
+    return result;
+}
+
+auto TaskTable::index_insert(int id, std::size_t row) -> void {
+    if (id < 0) {
+        throw std::runtime_error("Negative task id in TaskTable");
+    }
+    if (!m_index.emplace(id, static_cast<int>(row)).second) {
+        throw std::runtime_error("Duplicate task id in TaskTable");
+    }
+}
+
+auto TaskTable::from_map(const std::unordered_map<int, TaskRef> &tasks)
+    -> TaskTable {
+    std::vector<int> keys;
+    keys.reserve(tasks.size());
+    for (const auto &pair : tasks) {
+        keys.push_back(pair.first);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    TaskTable table;
+    table.reserve(keys.size());
+    std::vector<std::pair<int, int>> edges;
+    for (auto id : keys) {
+        const auto &task = tasks.at(id);
+        if (!task) {
+            throw std::runtime_error("Null task encountered in from_map");
+        }
+        table.push_back(id, task->getClb(), task->getDsp(), task->getBram(),
+                        task->getExec(), task->getConf());
+        for (auto child : task->getChildren()) {
+            edges.emplace_back(id, child);
+        }
+    }
+    if (!edges.empty()) {
+        table.set_edges(edges);
+    }
+    return table;
+}
+
+auto TaskTable::to_task(std::size_t row) const -> TaskRef {
+    auto ids_of = [&](Span<const int> rows) {
+        std::vector<int> ids(rows.size());
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            ids[i] = m_id[rows[i]];
+        }
+        return ids;
+    };
+    auto task = std::make_shared<Task>(m_id[row], m_clb[row], m_dsp[row],
+                                       m_bram[row], m_exec[row],
+                                       ids_of(children(row)),
+                                       ids_of(parents(row)));
+    task->setConf(m_conf[row]);
+    return task;
+}
+
+auto TaskTable::to_map() const -> std::unordered_map<int, TaskRef> {
+    std::unordered_map<int, TaskRef> tasks;
+    tasks.reserve(size());
+    for (std::size_t row = 0; row < size(); ++row) {
+        tasks[m_id[row]] = to_task(row);
+    }
+    return tasks;
+}
+
+} // namespace seu
@@ -0,0 +1,109 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace seu {
+
+ThreadPool::ThreadPool(std::size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m_workers.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        m_workers.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto &worker : m_workers) {
+        worker.join();
+    }
+}
+
+auto ThreadPool::enqueue(std::function<void()> job) -> void {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push(std::move(job));
+    }
+    m_cv.notify_one();
+}
+
+auto ThreadPool::worker_loop() -> void {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+            if (m_stop && m_jobs.empty()) {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop();
+        }
+        job();
+    }
+}
+
+auto ThreadPool::parallel_for(
+    std::size_t begin, std::size_t end, std::size_t chunk_size,
+    const std::function<void(std::size_t, std::size_t, std::size_t)> &fn)
+    -> void {
+    if (begin >= end) {
+        return;
+    }
+    if (chunk_size == 0) {
+        chunk_size = 1;
+    }
+    const std::size_t num_chunks = (end - begin + chunk_size - 1) / chunk_size;
+
+    // 所有参与者从同一个计数器领取块；调用线程也领取，
+    // 所以即使池中线程全忙（例如嵌套调用），任务也总能完成
+    struct State {
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+
+    auto run_chunks = [state, begin, end, chunk_size, num_chunks, &fn]() {
+        std::size_t c;
+        while ((c = state->next.fetch_add(1)) < num_chunks) {
+            std::size_t lo = begin + c * chunk_size;
+            std::size_t hi = std::min(end, lo + chunk_size);
+            try {
+                fn(lo, hi, c);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error) {
+                    state->error = std::current_exception();
+                }
+            }
+            if (state->done.fetch_add(1) + 1 == num_chunks) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->cv.notify_all();
+            }
+        }
+    };
+
+    std::size_t helpers = std::min(m_workers.size(), num_chunks - 1);
+    for (std::size_t i = 0; i < helpers; ++i) {
+        enqueue(run_chunks);
+    }
+    run_chunks();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&]() { return state->done.load() == num_chunks; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+} // namespace seu
@@ -1,6 +1,7 @@
 #include "utils.h"
 #include <filesystem>
 #include <fstream>
+#include <glob.h>
 #include <limits.h>
 #include <sstream>
 #include <string>
@@ -19,12 +20,26 @@ auto Utils::get_current_working_directory() -> std::string {
     }
 }
 
+// 只在第一次调用时查找，之后切换工作目录不会改变结果
 auto Utils::get_project_root() -> std::string {
-    fs::path p = fs::current_path();
-    while (p != p.root_path() && !fs::exists(p / "CMakeLists.txt")) {
-        p = p.parent_path();
+    static const std::string root = [] {
+        fs::path p = fs::current_path();
+        while (p != p.root_path() && !fs::exists(p / "CMakeLists.txt")) {
+            p = p.parent_path();
+        }
+        return p.string();
+    }();
+    return root;
+}
+
+auto Utils::glob(const std::string &pattern) -> std::vector<std::string> {
+    std::vector<std::string> paths;
+    glob_t result{};
+    if (::glob(pattern.c_str(), 0, nullptr, &result) == 0) {
+        paths.assign(result.gl_pathv, result.gl_pathv + result.gl_pathc);
     }
-    return p.string();
+    globfree(&result);
+    return paths;
 }
 
 } // namespace seu
@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// 统计全局 operator new 的调用次数，检查访问器与热点路径没有隐藏的分配
+// 1. 替换全部 new/delete 重载（含 nothrow、数组与对齐版本），统一由
+//    malloc/aligned_alloc 分配、free 释放，标准库内部经由任一重载分配的
+//    内存都能正确释放，ASan 下不会报 alloc-dealloc-mismatch
+// 2. 替换函数不能 inline，每个测试程序只能有一个源文件包含本头文件
+static std::atomic<long> g_allocations{0};
+
+namespace seu::test {
+
+static auto counted_alloc(std::size_t size, std::size_t align) -> void * {
+    g_allocations++;
+    if (size == 0) {
+        size = 1;
+    }
+    if (align <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    // aligned_alloc 要求大小是对齐值的整数倍
+    return std::aligned_alloc(align, (size + align - 1) / align * align);
+}
+
+static auto counted_new(std::size_t size, std::size_t align) -> void * {
+    if (void *p = counted_alloc(size, align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace seu::test
+
+void *operator new(std::size_t size) {
+    return seu::test::counted_new(size, 0);
+}
+void *operator new[](std::size_t size) {
+    return seu::test::counted_new(size, 0);
+}
+void *operator new(std::size_t size, std::align_val_t align) {
+    return seu::test::counted_new(size, static_cast<std::size_t>(align));
+}
+void *operator new[](std::size_t size, std::align_val_t align) {
+    return seu::test::counted_new(size, static_cast<std::size_t>(align));
+}
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return seu::test::counted_alloc(size, 0);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return seu::test::counted_alloc(size, 0);
+}
+void *operator new(std::size_t size, std::align_val_t align,
+                   const std::nothrow_t &) noexcept {
+    return seu::test::counted_alloc(size, static_cast<std::size_t>(align));
+}
+void *operator new[](std::size_t size, std::align_val_t align,
+                     const std::nothrow_t &) noexcept {
+    return seu::test::counted_alloc(size, static_cast<std::size_t>(align));
+}
+
+// GCC 把内联后的 free 与调用方的 new 配对检查，这里本就统一用 free 释放
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+    std::free(p);
+}
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+    std::free(p);
+}
+void operator delete(void *p, std::align_val_t,
+                     const std::nothrow_t &) noexcept {
+    std::free(p);
+}
+void operator delete[](void *p, std::align_val_t,
+                       const std::nothrow_t &) noexcept {
+    std::free(p);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,121 @@
+#include "solver/floorplan_dse.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main() {
+    // 布局 DSE：网格去重；结果文件中已有（含写了一半的行）时续跑不再求解
+    seu::DseSpace space;
+    space.module_counts = {1, 2, 2};
+    space.preemptive_FRI = {false, true};
+    auto dse_points = space.grid();
+    auto dse_unique = seu::floorplan_dse::dedup(dse_points);
+    auto dse_path = std::filesystem::temp_directory_path() / "seu_dse.csv";
+    seu::DseOptions dse_options;
+    dse_options.output = dse_path.string();
+    seu::floorplan_dse dse({{100, 2, 4, 5, 50}, {200, 4, 8, 5, 50}}, {},
+                           dse_options);
+    {
+        std::ofstream out(dse_path);
+        out << "# seu floorplan_dse v4 " << std::hex << dse.fingerprint()
+            << std::dec << "\nnum_modules,preemptive_FRI\n";
+        for (const auto &p : dse_unique) {
+            out << p.num_modules << "," << p.preemptive_FRI << ",0,0,1,0,0,0,2,"
+                << 10 * p.num_modules << ",1,0,0,0,0,0.5\n";
+        }
+        out << "3,0,1,0";
+    }
+    auto dse_results = dse.run(dse_points);
+    std::filesystem::remove(dse_path);
+    if (dse_points.size() != 6 || dse_unique.size() != 4 ||
+        dse_results.size() != 4 || dse_results[3].objective != 20 ||
+        dse_results[3].point.key() != dse_unique[3].key()) {
+        std::cerr << "DSE grid, dedup or resume is wrong" << std::endl;
+        return 1;
+    }
+    // 取值越界的行被忽略；没有版本行或没有指纹的旧格式文件报错
+    {
+        std::ofstream out(dse_path);
+        out << "# seu floorplan_dse v4 0\nnum_modules\n"
+            << "1,0,7,0,1,0,0,0,2,10,1,0,0,0,0,0.5\n"
+            << "1,0,0,9,1,0,0,0,2,10,1,0,0,0,0,0.5\n";
+    }
+    bool out_of_range_skipped = seu::floorplan_dse::load(
+                                    dse_path.string()).empty();
+    int old_format_rejected = 0;
+    for (const char *old_header : {"", "# seu floorplan_dse v3\n"}) {
+        {
+            std::ofstream out(dse_path);
+            out << old_header << "num_modules,preemptive_FRI\n"
+                << "1,0,0,0,1,0,0,0,2,10,1,0,0,0,0,0.5\n";
+        }
+        try {
+            seu::floorplan_dse::load(dse_path.string());
+        } catch (const std::runtime_error &) {
+            old_format_rejected++;
+        }
+    }
+    std::filesystem::remove(dse_path);
+    if (!out_of_range_skipped || old_format_rejected != 2) {
+        std::cerr << "DSE output format checks are wrong" << std::endl;
+        return 1;
+    }
+    // 某个点求解出错时记录状态与异常信息，其余点照常求解，出错的点不落盘
+    struct flaky_dse : seu::floorplan_dse {
+        using floorplan_dse::floorplan_dse;
+        auto solve(seu::milp_solver_pynq &, const seu::DsePoint &point,
+                   double) -> seu::DseResult override {
+            if (point.num_modules == 2) {
+                throw std::runtime_error("stub solver failure");
+            }
+            seu::DseResult result;
+            result.point = point;
+            result.status = 2;
+            result.objective = point.num_modules;
+            return result;
+        }
+    };
+    dse_options.threads = 2;
+    flaky_dse flaky({{100, 2, 4, 5, 50}, {200, 4, 8, 5, 50}}, {},
+                    dse_options);
+    auto flaky_results = flaky.run(dse_unique);
+    auto flaky_saved = seu::floorplan_dse::load(dse_options.output);
+    // 模块、连接或时间限制不同时，不续用按其他输入求得的结果
+    auto other_options = dse_options;
+    other_options.time_limit = 60;
+    flaky_dse other_limit({{100, 2, 4, 5, 50}, {200, 4, 8, 5, 50}}, {},
+                          other_options);
+    flaky_dse other_connections({{100, 2, 4, 5, 50}, {200, 4, 8, 5, 50}},
+                                {{1, 2, 8}}, dse_options);
+    flaky_dse other_modules({{100, 2, 4, 5, 50}, {200, 4, 8, 6, 50}}, {},
+                            dse_options);
+    int mismatch_rejected = 0;
+    for (auto *other : {&other_limit, &other_connections, &other_modules}) {
+        try {
+            other->run(dse_unique);
+        } catch (const std::runtime_error &) {
+            mismatch_rejected++;
+        }
+    }
+    std::filesystem::remove(dse_path);
+    if (mismatch_rejected != 3) {
+        std::cerr << "DSE resumed from another input " << 3 - mismatch_rejected
+                  << " times" << std::endl;
+        return 1;
+    }
+    int failed = 0, solved = 0;
+    for (const auto &r : flaky_results) {
+        failed += r.status == seu::DSE_FAILED &&
+                  r.error == "stub solver failure";
+        solved += r.status == 2;
+    }
+    if (failed != 2 || solved != 2 || flaky_saved.size() != 2) {
+        std::cerr << "DSE failures: " << failed << " failed, " << solved
+                  << " solved, " << flaky_saved.size() << " saved"
+                  << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include "alloc_counter.h"
+#include "solver/interference.h"
+#include <iostream>
+#include <vector>
+
+int main() {
+    // 干扰分析：HW 任务 0、2 共用分区 0，分区重配置时间为 4
+    seu::Platform pynq_platform(1);
+    pynq_platform.maxFPGAResources = {100};
+    pynq_platform.recTimePerUnit = {1.0};
+    seu::Taskset taskset(3, 2, pynq_platform);
+    const double wcet[] = {10, 20, 5};
+    const double demand[] = {4, 6, 3};
+    for (unsigned a = 0; a < 3; ++a) {
+        taskset.HW_Tasks[a].WCET = wcet[a];
+        taskset.HW_Tasks[a].resDemand = {demand[a]};
+        taskset.HW_Tasks[a].SW_Task_ID = a < 2 ? 0 : 1;
+    }
+    taskset.SW_Tasks[0].H = {0, 1};
+    taskset.SW_Tasks[1].H = {2};
+    seu::interference_analysis interference(taskset, pynq_platform);
+    auto bounds = interference.evaluate({0, 1, 0}, {43, 23}, true);
+    if (!bounds.feasible || bounds.response[0] != 43 ||
+        bounds.response[1] != 23 || bounds.i_slot[0 * 3 + 2] != 5 ||
+        bounds.delta[0 * 2 + 1] != 9 ||
+        interference.feasible({0, 1, 0}, {43, 22}, true)) {
+        std::cerr << "Interference response times: " << bounds.response[0]
+                  << ", " << bounds.response[1] << std::endl;
+        return 1;
+    }
+    // 筛选布局方案时重复分析同一规模的分配，复用内部缓冲区，不分配内存
+    const std::vector<int> screened = {0, 1, 0};
+    const std::vector<double> screened_slacks = {43, 23};
+    long allocations = g_allocations;
+    for (int repeat = 0; repeat < 100; ++repeat) {
+        interference.feasible(screened, screened_slacks, true);
+    }
+    if (g_allocations != allocations) {
+        std::cerr << "Interference screening allocated "
+                  << g_allocations - allocations << " times" << std::endl;
+        return 1;
+    }
+    // 与当前 MILP 一致的模型：r 与 DELTA_NP 为 0，只剩执行时间的干扰
+    seu::interference_analysis built(taskset, pynq_platform,
+                                     seu::InterferenceModel::AS_BUILT);
+    auto built_bounds = built.evaluate({0, 1, 0}, {35, 15}, false);
+    if (!built_bounds.feasible || built_bounds.response[0] != 35 ||
+        built_bounds.response[1] != 15 || built_bounds.rec_time[0] != 0 ||
+        built.feasible({0, 1, 0}, {35, 14}, false)) {
+        std::cerr << "As-built interference response times: "
+                  << built_bounds.response[0] << ", "
+                  << built_bounds.response[1] << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
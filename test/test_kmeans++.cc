@@ -1,8 +1,18 @@
+#include "alloc_counter.h"
+#include "solver/kmeans_hamerly.h"
+#include "solver/kmeans_metric.h"
+#include "solver/kmeans_sweep.h"
 #include "solver/kmeanspp.h"
 #include "task.h"
 #include "task_manager.h"
+#include "task_stream.h"
+#include "thread_pool.h"
+#include "utils.h"
+#include <algorithm>
+#include <fstream>
 #include <memory>
 #include <ostream>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -11,7 +21,7 @@ int main() {
     // TM->init_from_random(20);
     // 随机生成
     TM->init_from_json("test.json");
-    auto random_task_set = TM->getJsonTask();
+    const auto &random_task_set = TM->getJsonTask();
     // seu::TaskManager::TaskInfoPrint(random_task_set);
     std::vector<seu::TaskRef> centroids;
     std::unordered_map<int, int> assignments;
@@ -66,5 +76,296 @@ int main() {
 
     std::cout << "Data has been written to output.csv" << std::endl;
 
+    // 空任务集不能初始化中心，k 为 0 时不选中心
+    std::vector<seu::TaskRef> no_centroids;
+    bool empty_rejected = false;
+    try {
+        seu::kmeanspp::initCentroidsKMeansPlusPlus({}, no_centroids, k);
+    } catch (const std::runtime_error &) {
+        empty_rejected = true;
+    }
+    seu::kmeanspp::initCentroidsKMeansPlusPlus(random_task_set, no_centroids,
+                                               0);
+    if (!empty_rejected || !no_centroids.empty()) {
+        std::cerr << "Centroid seeding accepted an empty input" << std::endl;
+        return 1;
+    }
+
+    // 访问器返回引用：读取每个任务的依赖与资源、在已有结果上重新分配
+    // 不分配内存；按 map 求各类最大资源只分配与类数相关的内存
+    seu::TaskTable linked_table = TM->getJsonTaskTable();
+    auto linked_ids = linked_table.ids();
+    std::vector<std::pair<int, int>> links;
+    for (std::size_t row = 1; row < linked_ids.size(); ++row) {
+        links.emplace_back(linked_ids[row - 1], linked_ids[row]);
+    }
+    linked_table.set_edges(links);
+    auto linked = linked_table.to_map();
+    long allocations = g_allocations;
+    long touched = 0;
+    for (const auto &[id, task] : linked) {
+        const auto [clb, dsp, bram] = task->getResources();
+        touched += task->getChildren().size() + task->getParent().size() +
+                   clb + dsp + bram;
+    }
+    seu::kmeanspp::assignTasks(random_task_set, centroids, assignments);
+    if (touched <= 0 || g_allocations != allocations) {
+        std::cerr << "Task accessors allocated "
+                  << g_allocations - allocations << " times" << std::endl;
+        return 1;
+    }
+    allocations = g_allocations;
+    seu::kmeanspp::getClusterMaxResourcesNumber(clusterToTask,
+                                                random_task_set);
+    if (g_allocations - allocations > 2 * k + 8) {
+        std::cerr << "Cluster maximum allocated "
+                  << g_allocations - allocations << " times" << std::endl;
+        return 1;
+    }
+
+    // 按列存储的任务表路径
+    const auto &task_table = TM->getJsonTaskTable();
+    std::vector<seu::Centroid> table_centroids(k);
+    std::vector<int> table_assignments;
+    seu::kmeanspp::kMeansPlusPlusClustering(task_table, table_centroids,
+                                            table_assignments, tolerance,
+                                            max_iterations);
+    if (table_assignments.size() != task_table.size()) {
+        std::cerr << "TaskTable clustering lost tasks" << std::endl;
+        return 1;
+    }
+    for (auto c : table_assignments) {
+        if (c < 0 || c >= k) {
+            std::cerr << "TaskTable clustering bad cluster " << c << std::endl;
+            return 1;
+        }
+    }
+    auto table_info = seu::kmeanspp::getClusterMaxResourcesNumber(
+        task_table, table_assignments, k);
+    for (int i = 0; i < k; ++i) {
+        std::cout << "table cluster " << i << ": "
+                  << std::get<0>(table_info[i]) << " "
+                  << std::get<1>(table_info[i]) << " "
+                  << std::get<2>(table_info[i]) << std::endl;
+    }
+
+    // Hamerly 引擎与 Lloyd 迭代从相同初始中心出发，结果应一致
+    std::vector<seu::Centroid> init_centroids;
+    seu::kmeanspp::initCentroidsKMeansPlusPlus(task_table, init_centroids, k);
+    std::vector<seu::Centroid> lloyd_centroids = init_centroids;
+    std::vector<seu::Centroid> old_centroids;
+    std::vector<int> lloyd_assignments;
+    do {
+        old_centroids = lloyd_centroids;
+        seu::kmeanspp::assignTasks(task_table, lloyd_centroids,
+                                   lloyd_assignments);
+        seu::kmeanspp::updateCentroids(task_table, lloyd_assignments,
+                                       lloyd_centroids);
+    } while (!seu::kmeanspp::isConverged(old_centroids, lloyd_centroids, 0.0));
+
+    auto packed = seu::PackedTasks::from_table(task_table);
+    seu::kmeans_hamerly hamerly(packed);
+    std::vector<seu::Centroid> hamerly_centroids = init_centroids;
+    std::vector<int> hamerly_assignments;
+    hamerly.run(hamerly_centroids, hamerly_assignments, 0.0, 1000);
+    if (hamerly_assignments != lloyd_assignments) {
+        std::cerr << "Hamerly assignments differ from Lloyd" << std::endl;
+        return 1;
+    }
+    std::cout << "hamerly distance evaluations: "
+              << hamerly.distance_evaluations() << std::endl;
+
+    // 增量 Lloyd 迭代与普通 Lloyd 迭代收敛到相同的分配
+    seu::ClusterOptions incremental_options;
+    incremental_options.engine = seu::AssignEngine::INCREMENTAL;
+    incremental_options.max_iterations = 1000;
+    std::vector<seu::Centroid> incremental_centroids(k);
+    std::vector<int> incremental_assignments;
+    auto stats = seu::kmeanspp::kMeansPlusPlusClustering(
+        task_table, incremental_centroids, incremental_assignments,
+        incremental_options);
+    if (incremental_assignments != lloyd_assignments) {
+        std::cerr << "Incremental assignments differ from Lloyd" << std::endl;
+        return 1;
+    }
+    std::cout << "incremental iterations: " << stats.iterations
+              << ", moved tasks: " << stats.moved_tasks
+              << ", distance evaluations: " << stats.distance_evaluations
+              << std::endl;
+    // 上下界跳过不会改变归属的任务，距离计算少于每轮全部重算
+    const long full_scan = static_cast<long>(task_table.size()) * k;
+    if (stats.distance_evaluations >= full_scan * (stats.iterations + 1)) {
+        std::cerr << "Incremental assignment did not skip any task"
+                  << std::endl;
+        return 1;
+    }
+
+    // 编译期距离度量：欧式度量从相同初始中心出发应与 Lloyd 一致
+    seu::ClusterOptions metric_options;
+    metric_options.seeding = seu::SeedMode::PROVIDED;
+    metric_options.max_iterations = 1000;
+    std::vector<seu::Centroid> metric_centroids = init_centroids;
+    std::vector<int> metric_assignments;
+    auto metric_stats =
+        seu::kmeans_metric<seu::EuclideanMetric>(task_table, {})
+            .run(metric_centroids, metric_assignments, metric_options);
+    if (metric_assignments != lloyd_assignments ||
+        metric_stats.distance_evaluations >=
+            full_scan * (metric_stats.iterations + 1)) {
+        std::cerr << "Euclidean metric differs from Lloyd" << std::endl;
+        return 1;
+    }
+    auto check_metric = [&](auto metric, const char *name) {
+        seu::ClusterOptions options;
+        std::vector<seu::Centroid> centroids(k);
+        std::vector<int> assignments;
+        seu::kmeans_metric<decltype(metric)>(task_table, metric)
+            .run(centroids, assignments, options);
+        for (auto c : assignments) {
+            if (c < 0 || c >= k) {
+                return false;
+            }
+        }
+        auto info = seu::kmeanspp::getClusterMaxResourcesNumber(
+            task_table, assignments, k);
+        int area = 0;
+        for (const auto &[clb, dsp, bram] : info) {
+            area += clb + dsp + bram;
+        }
+        std::cout << name << " metric area: " << area << std::endl;
+        return true;
+    };
+    if (!check_metric(seu::NormalizedMetric::fit(task_table), "normalized") ||
+        !check_metric(seu::WeightedMetric(1.0, 100.0, 100.0), "weighted") ||
+        !check_metric(seu::ChebyshevMetric(), "chebyshev") ||
+        !check_metric(seu::TileMetric(), "tile")) {
+        std::cerr << "Metric clustering bad cluster" << std::endl;
+        return 1;
+    }
+
+    // k-means|| 初始化：相同种子下，单线程与多线程结果一致
+    seu::ClusterOptions parallel_options;
+    parallel_options.seeding = seu::SeedMode::KMEANS_PARALLEL;
+    parallel_options.engine = seu::AssignEngine::HAMERLY;
+    parallel_options.seed = 7;
+    std::vector<seu::Centroid> serial_centroids(k);
+    std::vector<int> serial_assignments;
+    seu::kmeanspp::kMeansPlusPlusClustering(task_table, serial_centroids,
+                                            serial_assignments,
+                                            parallel_options);
+
+    seu::ThreadPool pool(4);
+    parallel_options.pool = &pool;
+    std::vector<seu::Centroid> pooled_centroids(k);
+    std::vector<int> pooled_assignments;
+    seu::kmeanspp::kMeansPlusPlusClustering(task_table, pooled_centroids,
+                                            pooled_assignments,
+                                            parallel_options);
+    if (serial_assignments != pooled_assignments) {
+        std::cerr << "k-means|| result depends on thread count" << std::endl;
+        return 1;
+    }
+
+    // mini-batch 聚类，再按流统计每类资源最大值，应与按表统计的结果一致
+    std::string json_path =
+        seu::Utils::get_project_root() + "/src/info/taskinfo/test.json";
+    seu::JsonTaskStream json_stream(json_path, seu::JsonReadMode::BUFFERED,
+                                    256);
+    seu::ClusterOptions minibatch_options;
+    minibatch_options.batch_size = 16;
+    std::vector<seu::Centroid> minibatch_centroids(k);
+    auto minibatch_stats = seu::kmeanspp::kMeansPlusPlusClustering(
+        json_stream, minibatch_centroids, minibatch_options);
+    auto streamed_info = seu::kmeanspp::getClusterMaxResourcesNumber(
+        json_stream, minibatch_centroids, 16);
+    std::vector<int> minibatch_assignments;
+    seu::kmeanspp::assignTasks(task_table, minibatch_centroids,
+                               minibatch_assignments);
+    if (streamed_info != seu::kmeanspp::getClusterMaxResourcesNumber(
+                             task_table, minibatch_assignments, k)) {
+        std::cerr << "Streaming max resources differ from table" << std::endl;
+        return 1;
+    }
+    std::cout << "mini-batch batches: " << minibatch_stats.iterations
+              << std::endl;
+
+    // 多次重启：单线程与线程池选出的结果一致，且不差于任何一次单独运行
+    seu::ClusterOptions restart_options;
+    auto serial_best = seu::kmeanspp::kMeansPlusPlusRestarts(
+        task_table, k, 8, restart_options);
+    restart_options.pool = &pool;
+    auto pooled_best = seu::kmeanspp::kMeansPlusPlusRestarts(
+        task_table, k, 8, restart_options);
+    if (serial_best.assignments != pooled_best.assignments ||
+        serial_best.seed != pooled_best.seed) {
+        std::cerr << "Restart result depends on thread count" << std::endl;
+        return 1;
+    }
+    for (int r = 0; r < 8; ++r) {
+        seu::ClusterOptions single_options;
+        single_options.seed = seu::KMEANS_DEFAULT_SEED + r;
+        std::vector<seu::Centroid> single_centroids(k);
+        std::vector<int> single_assignments;
+        seu::kmeanspp::kMeansPlusPlusClustering(
+            task_table, single_centroids, single_assignments, single_options);
+        if (seu::kmeanspp::inertia(task_table, single_centroids,
+                                   single_assignments) < serial_best.score) {
+            std::cerr << "Restart did not pick the lowest inertia" << std::endl;
+            return 1;
+        }
+    }
+    auto footprint_best = seu::kmeanspp::kMeansPlusPlusRestarts(
+        task_table, k, 8, restart_options,
+        seu::RestartCriterion::MAX_RESOURCES);
+    std::cout << "best inertia: " << serial_best.score << " (seed "
+              << serial_best.seed << "), best footprint: "
+              << footprint_best.score << std::endl;
+
+    // k 扫描：单线程与线程池结果一致，前沿非空
+    seu::ClusterOptions sweep_options;
+    auto serial_sweep = seu::kmeans_sweep::run(task_table, 2, 9, sweep_options);
+    sweep_options.pool = &pool;
+    auto pooled_sweep = seu::kmeans_sweep::run(task_table, 2, 9, sweep_options);
+    if (serial_sweep.front.empty() ||
+        serial_sweep.front != pooled_sweep.front ||
+        serial_sweep.elbow != pooled_sweep.elbow) {
+        std::cerr << "k sweep front is empty or depends on thread count"
+                  << std::endl;
+        return 1;
+    }
+    // 前沿是真子集：area 最小的 k 在前沿上，面积更大而轮廓系数不更好的
+    // k 被支配
+    if (serial_sweep.front.size() >= serial_sweep.points.size()) {
+        std::cerr << "k sweep front contains every k" << std::endl;
+        return 1;
+    }
+    for (const auto &p : serial_sweep.points) {
+        bool on_front = std::find(serial_sweep.front.begin(),
+                                  serial_sweep.front.end(),
+                                  p.k) != serial_sweep.front.end();
+        bool dominated = false;
+        for (const auto &q : serial_sweep.points) {
+            dominated = dominated || (q.area <= p.area &&
+                                      q.silhouette >= p.silhouette &&
+                                      (q.area < p.area ||
+                                       q.silhouette > p.silhouette));
+        }
+        if (on_front == dominated) {
+            std::cerr << "k sweep front is wrong at k = " << p.k
+                      << std::endl;
+            return 1;
+        }
+    }
+    for (const auto &point : serial_sweep.points) {
+        std::cout << "k = " << point.k << ": area " << point.area
+                  << ", silhouette " << point.silhouette << ", inertia "
+                  << point.inertia << std::endl;
+    }
+    std::cout << "pareto front:";
+    for (auto front_k : serial_sweep.front) {
+        std::cout << " " << front_k;
+    }
+    std::cout << ", elbow k = " << serial_sweep.elbow << std::endl;
+
     return 0;
 }
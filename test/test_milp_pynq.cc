@@ -0,0 +1,30 @@
+#include "milp_solver_interface.h"
+#include <iostream>
+
+int main() {
+    // 建模方式不同时不复用模型；只有 TIGHT 且没有连接关系时对槽排序
+    seu::Platform shape_platform(3);
+    seu::Taskset shape_taskset(2, 1, shape_platform);
+    shape_taskset.HW_Tasks[0].SW_Task_ID = 0;
+    shape_taskset.HW_Tasks[1].SW_Task_ID = 0;
+    shape_taskset.SW_Tasks[0].H = {0, 1};
+    seu::pynq_context shape_ctx;
+    shape_ctx.num_slots = 2;
+    auto legacy_shape = seu::pynq_model_shape(shape_ctx, shape_taskset,
+                                              shape_platform, false);
+    bool legacy_sym = seu::pynq_breaks_symmetry(shape_ctx);
+    shape_ctx.formulation = seu::pynq_formulation::TIGHT;
+    auto tight_shape = seu::pynq_model_shape(shape_ctx, shape_taskset,
+                                             shape_platform, false);
+    bool tight_sym = seu::pynq_breaks_symmetry(shape_ctx);
+    shape_ctx.num_conn_slots_pynq = 1;
+    shape_ctx.conn_matrix_pynq[0] = {1, 2, 8};
+    bool connected_sym = seu::pynq_breaks_symmetry(shape_ctx);
+    if (legacy_shape == tight_shape || legacy_sym || !tight_sym ||
+        connected_sym) {
+        std::cerr << "PYNQ formulation switch is wrong" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "milp_solver_interface.h"
+#include "sim/pr_simulator.h"
+#include "task_graph.h"
+#include "task_table.h"
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+int main() {
+    // 部分重配置仿真：同一模块连续执行只配置一次，ICAP 时间计入利用率
+    seu::TaskTable sim_tasks;
+    sim_tasks.push_back(1, 1000, 10, 10, 20);
+    sim_tasks.push_back(2, 1000, 10, 10, 30);
+    sim_tasks.push_back(3, 1000, 10, 10, 10);
+    sim_tasks.set_edges({{1, 2}, {1, 3}, {2, 3}});
+    seu::SimConfig sim_config;
+    sim_config.partitions = {{4500, 100, 100}, {4500, 100, 100}};
+    sim_config.allocation = {0, 1, 0};
+    sim_config.rec_time_per_unit = {1.0 / 4500.0, 1.0 / 4500.0, 1.0 / 4000.0};
+    // 模拟器只保存任务表的引用，不能由临时任务表构造
+    static_assert(!std::is_constructible_v<seu::PrSimulator, seu::TaskTable,
+                                           seu::SimConfig>);
+    seu::PrSimulator simulator(sim_tasks, sim_config);
+    auto dag_report = simulator.run_graph();
+    auto trace_report = simulator.run({{0, 0.0}, {0, 1.0}, {1, 0.0}});
+    seu::TaskGraph sim_graph(sim_tasks);
+    if (dag_report.unfinished != 0 || dag_report.reconfigurations != 3 ||
+        dag_report.makespan < sim_graph.critical_path_length() ||
+        trace_report.reconfigurations != 2 ||
+        trace_report.icap_utilization <= 0.0 ||
+        simulator.status(0) != seu::TaskStatus::ENDING) {
+        std::cerr << "PrSimulator produced an inconsistent report" << std::endl;
+        return 1;
+    }
+    // 调度策略：分区 0 上交替出现两个模块，优先执行已配置模块的作业
+    // 可以减少配置次数
+    std::vector<seu::SimJob> alternating = {{0, 0.0}, {2, 0.0}, {0, 0.0},
+                                            {2, 0.0}};
+    auto fifo_report = simulator.run(alternating);
+    simulator.set_scheduler(
+        seu::make_scheduler(seu::SchedulePolicy::LEAST_RECONFIG));
+    auto reuse_report = simulator.run(alternating);
+    if (fifo_report.reconfigurations != 4 ||
+        reuse_report.reconfigurations != 2) {
+        std::cerr << "Scheduler reconfigurations: fifo "
+                  << fifo_report.reconfigurations << ", least-reconfig "
+                  << reuse_report.reconfigurations << std::endl;
+        return 1;
+    }
+    // 位流缓存：两个模块分别留在两个分区中，第二次执行模块 0 时命中
+    std::vector<seu::SimJob> revisits = {{0, 0.0}, {2, 100.0}, {0, 200.0}};
+    auto cached_config = sim_config;
+    cached_config.placement = seu::Placement::CACHE;
+    seu::PrSimulator cached(sim_tasks, cached_config);
+    auto static_report = simulator.run(revisits);
+    auto cache_report = cached.run(revisits);
+    if (static_report.reconfigurations != 3 || cache_report.cache_hits != 1 ||
+        cache_report.rec_time_saved <= 0.0) {
+        std::cerr << "Bitstream cache hits: " << cache_report.cache_hits
+                  << std::endl;
+        return 1;
+    }
+    // 两个分区都忙时，未命中的作业由先空闲的分区领取，而不是在就绪时
+    // 就排到某个分区后面
+    seu::TaskTable busy_tasks;
+    busy_tasks.push_back(0, 1000, 10, 10, 100);
+    busy_tasks.push_back(1, 1000, 10, 10, 20);
+    busy_tasks.push_back(2, 1000, 10, 10, 10);
+    std::vector<seu::SimJob> busy_jobs = {{0, 0.0}, {1, 0.0}, {2, 5.0}};
+    for (auto policy : {seu::SchedulePolicy::FIFO,
+                        seu::SchedulePolicy::LEAST_RECONFIG}) {
+        seu::PrSimulator busy(busy_tasks, cached_config);
+        busy.set_scheduler(seu::make_scheduler(policy));
+        auto busy_report = busy.run(busy_jobs);
+        if (busy_report.unfinished != 0 || busy_report.finish[2] > 50.0) {
+            std::cerr << "Cached job waited for a busy partition: finished at "
+                      << busy_report.finish[2] << std::endl;
+            return 1;
+        }
+    }
+    // DAG 预取：父任务开始运行后，空闲分区提前配置子任务的模块
+    seu::PrSimulator prefetching(sim_tasks, sim_config);
+    prefetching.set_scheduler(
+        seu::make_scheduler(seu::SchedulePolicy::PREFETCH));
+    auto prefetch_report = prefetching.run_graph();
+    if (prefetch_report.unfinished != 0 || prefetch_report.prefetch_hits == 0 ||
+        prefetch_report.makespan >= dag_report.makespan) {
+        std::cerr << "DAG prefetch makespan: " << prefetch_report.makespan
+                  << ", without prefetch " << dag_report.makespan << std::endl;
+        return 1;
+    }
+
+    // 截止时间来自求解输入的 slacks：分区 0 执行完模块 0 后，EDF 先执行
+    // 截止时间近的模块 2，FIFO 先执行模块 1 而使模块 2 超时
+    seu::Platform edf_platform(3);
+    edf_platform.recTimePerUnit = sim_config.rec_time_per_unit;
+    seu::Taskset edf_taskset(3, 3, edf_platform);
+    for (unsigned a = 0; a < 3; ++a) {
+        edf_taskset.SW_Tasks[a].H = {a};
+    }
+    std::vector<double> edf_slacks = {100, 100, 20};
+    std::vector<int> edf_clb = {4500}, edf_bram = {100}, edf_dsp = {100};
+    std::vector<seu::hw_task_allocation> edf_alloc(1);
+    edf_alloc[0].task_id = {0, 1, 2};
+    seu::param_from_solver edf_solution(1, 3, nullptr, nullptr, nullptr,
+                                        nullptr, &edf_clb, &edf_bram,
+                                        &edf_dsp, &edf_alloc);
+    seu::param_to_solver edf_problem;
+    edf_problem.task_set = &edf_taskset;
+    edf_problem.platform = &edf_platform;
+    edf_problem.slacks = &edf_slacks;
+    auto edf_config = seu::SimConfig::from_solver(edf_solution, edf_problem);
+    seu::TaskTable edf_tasks;
+    edf_tasks.push_back(0, 1000, 10, 10, 5);
+    edf_tasks.push_back(1, 1000, 10, 10, 20);
+    edf_tasks.push_back(2, 1000, 10, 10, 5);
+    std::vector<seu::SimJob> edf_jobs = {{0, 0.0}, {1, 1.0}, {2, 1.0}};
+    seu::PrSimulator edf_sim(edf_tasks, edf_config);
+    auto edf_fifo = edf_sim.run(edf_jobs);
+    edf_sim.set_scheduler(seu::make_scheduler(seu::SchedulePolicy::EDF));
+    auto edf_report = edf_sim.run(edf_jobs);
+    if (edf_config.slacks != edf_slacks || edf_fifo.deadline_misses != 1 ||
+        edf_report.deadline_misses != 0) {
+        std::cerr << "EDF deadline misses: " << edf_report.deadline_misses
+                  << ", FIFO " << edf_fifo.deadline_misses << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
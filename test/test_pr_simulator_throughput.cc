@@ -0,0 +1,57 @@
+#include "rng.h"
+#include "sim/pr_simulator.h"
+#include "task_manager.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// 仿真吞吐量：200 个模块、8 个相同分区，作业按平均 2.5 的间隔随机释放
+// 默认 2M 个作业，可由第一个参数指定作业数；只报告耗时，不以耗时判定失败
+int main(int argc, char **argv) {
+    const long num_jobs = argc > 1 ? std::atol(argv[1]) : 2000000;
+    const int num_modules = 200;
+
+    seu::TaskGenSpec spec;
+    spec.clb = {500, 4000};
+    spec.dsp = {0, 50};
+    spec.bram = {0, 50};
+    auto tasks = seu::TaskManager::generate_task_table(num_modules, spec, 0);
+    seu::SimConfig config;
+    config.partitions.assign(8, {4500, 100, 100});
+    config.rec_time_per_unit = {1.0 / 4500.0, 1.0 / 4500.0, 1.0 / 4000.0};
+    seu::PrSimulator simulator(tasks, config);
+
+    std::vector<seu::SimJob> jobs(num_jobs);
+    seu::Rng rng(3);
+    double release = 0.0;
+    for (auto &job : jobs) {
+        job.row = rng.uniform_int(0, num_modules - 1);
+        release += rng.uniform01() * 5.0;
+        job.release = release;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    auto report = simulator.run(jobs);
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - begin)
+                         .count();
+    std::cout << num_jobs << " jobs on " << config.partitions.size()
+              << " partitions: " << report.events << " events in " << seconds
+              << " s (" << report.events / seconds / 1e6
+              << "M events/s), icap utilization " << report.icap_utilization
+              << ", reconfigurations " << report.reconfigurations
+              << std::endl;
+
+    // 每个作业至少经过释放与完成两个事件
+    if (report.unfinished != 0 ||
+        report.finish.size() != static_cast<std::size_t>(num_jobs) ||
+        report.events < 2 * num_jobs) {
+        std::cerr << "Throughput run lost jobs: " << report.unfinished
+                  << " unfinished, " << report.events << " events"
+                  << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include "rng.h"
+#include "task_manager.h"
+#include "thread_pool.h"
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <vector>
+
+int main() {
+    seu::ThreadPool pool(4);
+
+    // 随机数服务：相同种子生成的随机任务逐位相同
+    auto random_tasks = [](std::uint64_t seed) {
+        seu::RngService::set_seed(seed);
+        seu::TaskManager manager;
+        manager.init_from_random(200);
+        auto clb = manager.getRandomTaskTable().clb();
+        return std::vector<int>(clb.begin(), clb.end());
+    };
+    if (random_tasks(2024) != random_tasks(2024)) {
+        std::cerr << "Random tasks are not reproducible" << std::endl;
+        return 1;
+    }
+    // 其他线程按新种子的某个流重新初始化，不会混用旧种子；取副本的第一个
+    // 值，同一工作线程领到多个任务时结果不变
+    seu::RngService::set_seed(7);
+    std::vector<std::future<std::uint64_t>> draws;
+    for (size_t i = 0; i < pool.size(); ++i) {
+        draws.push_back(pool.submit(
+            [] { return seu::Rng(seu::RngService::local()).next(); }));
+    }
+    for (auto &draw : draws) {
+        const std::uint64_t value = draw.get();
+        bool from_stream = false;
+        for (std::uint64_t j = 1; j <= pool.size(); ++j) {
+            from_stream = from_stream || seu::Rng::stream(7, j).next() == value;
+        }
+        if (!from_stream) {
+            std::cerr << "Worker Rng is not seeded from the new seed"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
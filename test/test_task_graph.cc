@@ -0,0 +1,37 @@
+#include "task_graph.h"
+#include "task_manager.h"
+#include <iostream>
+
+int main() {
+    seu::TaskManager manager;
+    manager.init_from_json("test.json");
+    const auto &task_table = manager.getJsonTaskTable();
+    seu::TaskTable graph_source = task_table;
+    auto graph_ids = graph_source.ids();
+    graph_source.set_edges({{graph_ids[0], graph_ids[1]},
+                             {graph_ids[0], graph_ids[2]},
+                             {graph_ids[1], graph_ids[2]}});
+
+    // 依赖图：0 -> 1 -> 2 且 0 -> 2，关键路径经过全部三个任务
+    seu::TaskGraph graph(graph_source);
+    auto graph_exec = graph_source.exec();
+    auto path = graph.critical_path();
+    if (graph.level(2) != 2 || graph.level_count() != 3 ||
+        graph.critical_path_length() <
+            graph_exec[0] + graph_exec[1] + graph_exec[2] ||
+        path.size() < 2) {
+        std::cerr << "TaskGraph levels or critical path incorrect"
+                  << std::endl;
+        return 1;
+    }
+    seu::TaskTable cyclic = graph_source;
+    cyclic.set_edges({{graph_ids[0], graph_ids[1]},
+                      {graph_ids[1], graph_ids[2]},
+                      {graph_ids[2], graph_ids[0]}});
+    if (seu::TaskGraph::find_cycle(cyclic).size() != 3) {
+        std::cerr << "TaskGraph did not detect the cycle" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
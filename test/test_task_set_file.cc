@@ -0,0 +1,38 @@
+#include "task_manager.h"
+#include "task_set_file.h"
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+int main() {
+    seu::TaskManager manager;
+    manager.init_from_json("test.json");
+    const auto &task_table = manager.getJsonTaskTable();
+
+    // 二进制任务集：保存后重新加载，各列与依赖关系不变
+    seu::TaskTable binary_source = task_table;
+    auto source_ids = binary_source.ids();
+    binary_source.set_edges({{source_ids[0], source_ids[1]},
+                             {source_ids[0], source_ids[2]},
+                             {source_ids[1], source_ids[2]}});
+    std::string binary_path =
+        (std::filesystem::temp_directory_path() / "seu_test_tasks.bin")
+            .string();
+    seu::TaskSetFile::save(binary_path, binary_source);
+    seu::TaskTable binary_loaded = seu::TaskSetFile(binary_path).to_table();
+    std::filesystem::remove(binary_path);
+    bool binary_same = binary_loaded.size() == binary_source.size() &&
+                       binary_loaded.edges() == binary_source.edges() &&
+                       binary_loaded.parents(2).size() == 2;
+    for (size_t row = 0; binary_same && row < binary_source.size(); ++row) {
+        binary_same = binary_loaded.ids()[row] == binary_source.ids()[row] &&
+                      binary_loaded.clb()[row] == binary_source.clb()[row] &&
+                      binary_loaded.exec()[row] == binary_source.exec()[row];
+    }
+    if (!binary_same) {
+        std::cerr << "Binary task set round trip differs" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
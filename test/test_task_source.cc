@@ -0,0 +1,28 @@
+#include "task_manager.h"
+#include "task_source.h"
+#include "thread_pool.h"
+#include <iostream>
+
+int main() {
+    seu::TaskManager manager;
+    manager.init_from_json("test.json");
+    const auto &task_table = manager.getJsonTaskTable();
+    seu::ThreadPool pool(4);
+
+    // 多文件加载：同一文件加载两次，OFFSET 时 id 不冲突，KEEP 时相互覆盖
+    seu::TaskSource source;
+    source.add("test.json").add("test.jso?");
+    auto offset_shards = source.load(seu::IdRemap::OFFSET, &pool);
+    auto keep_shards = source.load(seu::IdRemap::KEEP);
+    const auto &shards = offset_shards.shards;
+    if (offset_shards.table.size() != 2 * task_table.size() ||
+        keep_shards.table.size() != task_table.size() ||
+        shards[1].id_offset <= shards[0].id_offset) {
+        std::cerr << "TaskSource merged " << offset_shards.table.size()
+                  << " / " << keep_shards.table.size() << " tasks"
+                  << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "task_manager.h"
+#include "task_stream.h"
+#include "utils.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main() {
+    seu::TaskManager manager;
+    manager.init_from_json("test.json");
+    const auto &task_table = manager.getJsonTaskTable();
+
+    // 流式读取 JSON：任务数与一次性读入相同
+    std::string json_path =
+        seu::Utils::get_project_root() + "/src/info/taskinfo/test.json";
+    seu::JsonTaskStream json_stream(json_path, seu::JsonReadMode::BUFFERED,
+                                    256);
+    seu::TaskBatch batch;
+    size_t streamed = 0;
+    long streamed_clb = 0;
+    while (json_stream.next_batch(16, batch) > 0) {
+        streamed += batch.size();
+        for (auto clb : batch.clb) {
+            streamed_clb += clb;
+        }
+    }
+    if (streamed != task_table.size()) {
+        std::cerr << "JsonTaskStream read " << streamed << " tasks, expected "
+                  << task_table.size() << std::endl;
+        return 1;
+    }
+    // 内存映射方式读到的任务与缓冲方式相同
+    seu::JsonTaskStream mapped_stream(json_path, seu::JsonReadMode::MAPPED);
+    seu::TaskRecord record;
+    size_t mapped = 0;
+    long mapped_clb = 0;
+    while (mapped_stream.next_task(record)) {
+        mapped++;
+        mapped_clb += record.clb;
+    }
+    if (mapped != streamed || mapped_clb != streamed_clb) {
+        std::cerr << "Mapped JsonTaskStream differs from buffered read"
+                  << std::endl;
+        return 1;
+    }
+    // 超出 int 范围的字段报错，而不是截断成错误的值
+    std::string huge_path =
+        (std::filesystem::temp_directory_path() / "seu_test_huge.json")
+            .string();
+    int huge_rejected = 0;
+    for (const char *huge : {R"({"tasks": [{"id": 1, "clb": 1e12}]})",
+                             R"({"tasks": [{"id": 1, "children": [3.5]}]})"}) {
+        {
+            std::ofstream out(huge_path);
+            out << huge;
+        }
+        try {
+            seu::JsonTaskStream huge_stream(huge_path);
+            huge_stream.next_task(record);
+        } catch (const std::runtime_error &) {
+            huge_rejected++;
+        }
+    }
+    std::filesystem::remove(huge_path);
+    if (huge_rejected != 2) {
+        std::cerr << "JsonTaskStream accepted an out-of-range field"
+                  << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "task_manager.h"
+#include "task_table.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+int main() {
+    auto TM = std::make_shared<seu::TaskManager>();
+    TM->init_from_json("test.json");
+    const auto &random_task_set = TM->getJsonTask();
+    seu::ThreadPool pool(4);
+
+    // 旧接口返回缓存的 map：多次调用得到同一组任务对象，重新加载后更新
+    bool same_map = &TM->getJsonTask() == &random_task_set &&
+                    TM->getJsonTask().begin()->second ==
+                        random_task_set.begin()->second;
+    seu::TaskManager reloaded;
+    reloaded.init_from_random(3);
+    auto before_reload = reloaded.getRandomTask().size();
+    reloaded.init_from_random(2);
+    if (!same_map || before_reload != 3 ||
+        reloaded.getRandomTask().size() != 5) {
+        std::cerr << "TaskManager map cache is wrong" << std::endl;
+        return 1;
+    }
+
+    // 稀疏 id：索引大小与任务数成正比，不随最大 id 增长
+    seu::TaskTable sparse;
+    sparse.push_back(2000000000, 100, 1, 1, 5);
+    sparse.append_rows(7, 2);
+    sparse.set_edges({{2000000000, 8}});
+    if (sparse.row_of(2000000000) != 0 || sparse.row_of(8) != 2 ||
+        sparse.contains(9) || sparse.children(0).size() != 1) {
+        std::cerr << "TaskTable sparse id index is wrong" << std::endl;
+        return 1;
+    }
+
+    // 批量生成：与线程数无关，且满足 random_task_gen.py 的比例约束
+    auto spec = seu::TaskGenSpec::python_script();
+    auto generated = seu::TaskManager::generate_task_table(200000, spec);
+    auto pooled_generated =
+        seu::TaskManager::generate_task_table(200000, spec, 0, &pool);
+    auto gen_clb = generated.clb();
+    auto gen_dsp = generated.dsp();
+    auto pooled_dsp = pooled_generated.dsp();
+    for (size_t row = 0; row < generated.size(); ++row) {
+        if (gen_dsp[row] != pooled_dsp[row] || gen_clb[row] < 400 ||
+            gen_clb[row] > 4000 ||
+            gen_dsp[row] < static_cast<int>(gen_clb[row] * 0.10) ||
+            gen_dsp[row] > static_cast<int>(gen_clb[row] * 0.15)) {
+            std::cerr << "Generated task " << row << " is out of spec"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}